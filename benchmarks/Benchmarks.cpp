@@ -0,0 +1,480 @@
+/**
+ * @file Benchmarks.cpp
+ * @brief Google Benchmark suite for the hot paths of the ECS (target ECS_bench)
+ *
+ * Every benchmark is parameterized by entity count and, where relevant, by the number
+ * of registered component types or systems. Build in Release and run e.g.
+ * `./ECS_bench --benchmark_filter=Destroy`.
+ */
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "ECS.hpp"
+
+namespace {
+
+/** Upper bound of the component-count parameter */
+constexpr std::size_t MAX_BENCH_COMPONENTS = 32;
+
+/** Upper bound of the system-count parameter */
+constexpr std::size_t MAX_BENCH_SYSTEMS = 64;
+
+/** Distinct component types, 16 bytes each */
+template <std::size_t I>
+struct Component {
+    float value[4];
+};
+
+/** Particle components, packed and SoA flavours */
+struct PackedPosition {
+    float x, y, z;
+};
+struct PackedVelocity {
+    float x, y, z;
+};
+struct SoAPosition {
+    float x, y, z;
+};
+struct SoAVelocity {
+    float x, y, z;
+};
+
+/** Empty marker component, stored as a tag */
+struct Marker {};
+
+} // namespace
+
+template <>
+struct SoALayout<SoAPosition> : SoAFields<&SoAPosition::x, &SoAPosition::y, &SoAPosition::z> {};
+template <>
+struct SoALayout<SoAVelocity> : SoAFields<&SoAVelocity::x, &SoAVelocity::y, &SoAVelocity::z> {};
+
+namespace {
+
+/** Distinct system types */
+template <std::size_t I>
+struct BenchSystem : System {};
+
+using EntityFn = void (*)(Coordinator &, Entity);
+using CoordinatorFn = void (*)(Coordinator &);
+using TypeFn = ComponentTypeID (*)();
+
+template <std::size_t I>
+void addOne(Coordinator &coordinator, Entity entity) {
+    coordinator.addComponent(entity, Component<I>{});
+}
+
+template <std::size_t I>
+void removeOne(Coordinator &coordinator, Entity entity) {
+    coordinator.removeComponent<Component<I>>(entity);
+}
+
+template <std::size_t I>
+void registerOne(Coordinator &coordinator) {
+    coordinator.registerComponent<Component<I>>();
+}
+
+template <std::size_t I>
+ComponentTypeID typeOf() {
+    return ComponentType::id<Component<I>>();
+}
+
+template <std::size_t... Is>
+constexpr std::array<EntityFn, sizeof...(Is)> makeAdders(std::index_sequence<Is...>) {
+    return {&addOne<Is>...};
+}
+
+template <std::size_t... Is>
+constexpr std::array<EntityFn, sizeof...(Is)> makeRemovers(std::index_sequence<Is...>) {
+    return {&removeOne<Is>...};
+}
+
+template <std::size_t... Is>
+constexpr std::array<CoordinatorFn, sizeof...(Is)> makeRegistrars(std::index_sequence<Is...>) {
+    return {&registerOne<Is>...};
+}
+
+template <std::size_t... Is>
+constexpr std::array<TypeFn, sizeof...(Is)> makeTypes(std::index_sequence<Is...>) {
+    return {&typeOf<Is>...};
+}
+
+/** Component type ID of Component<I>, indexed by I */
+constexpr auto TYPES = makeTypes(std::make_index_sequence<MAX_BENCH_COMPONENTS>{});
+
+/** addComponent of Component<I>, indexed by I */
+constexpr auto ADDERS = makeAdders(std::make_index_sequence<MAX_BENCH_COMPONENTS>{});
+
+/** removeComponent of Component<I>, indexed by I */
+constexpr auto REMOVERS = makeRemovers(std::make_index_sequence<MAX_BENCH_COMPONENTS>{});
+
+/** registerComponent of Component<I>, indexed by I */
+constexpr auto REGISTRARS = makeRegistrars(std::make_index_sequence<MAX_BENCH_COMPONENTS>{});
+
+/**
+ * @brief Registers BenchSystem<I> for every I, each requiring Component<I % components>
+ */
+template <std::size_t... Is>
+void registerSystems(Coordinator &coordinator, std::size_t count, std::size_t components, std::index_sequence<Is...>) {
+    ((Is < count ? (void)coordinator.registerSystem<BenchSystem<Is>>() : (void)0), ...);
+    (
+        [&] {
+            if (Is < count) {
+                Signature signature;
+                signature.set(TYPES[Is % components]());
+                coordinator.setSystemSignature<BenchSystem<Is>>(signature);
+            }
+        }(),
+        ...);
+}
+
+/**
+ * @brief Creates a coordinator sized for a benchmark, with components types registered
+ * @param entities Entity capacity
+ * @param components Number of Component<I> types to register
+ */
+std::unique_ptr<Coordinator> makeCoordinator(std::size_t entities, std::size_t components) {
+    auto coordinator = std::make_unique<Coordinator>();
+    CoordinatorConfig config;
+    config.maxEntities = static_cast<Entity>(entities);
+    coordinator->init(config);
+    for (std::size_t i = 0; i < components; ++i) {
+        REGISTRARS[i](*coordinator);
+    }
+    return coordinator;
+}
+
+/** Entity counts used by every benchmark */
+void entityCounts(benchmark::internal::Benchmark *benchmark) {
+    for (long entities : {1 << 10, 1 << 14, 1 << 17}) {
+        benchmark->Arg(entities);
+    }
+}
+
+/** Entity counts crossed with component-type counts */
+void entityAndComponentCounts(benchmark::internal::Benchmark *benchmark) {
+    for (long entities : {1 << 10, 1 << 14, 1 << 17}) {
+        for (long components : {1, 8, 32}) {
+            benchmark->Args({entities, components});
+        }
+    }
+}
+
+/** Entity counts crossed with system counts */
+void entityAndSystemCounts(benchmark::internal::Benchmark *benchmark) {
+    for (long entities : {1 << 10, 1 << 14}) {
+        for (long systems : {1, 16, 64}) {
+            benchmark->Args({entities, systems});
+        }
+    }
+}
+
+/** createEntity / destroyEntity churn over the whole capacity */
+void BM_CreateDestroyChurn(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 0);
+    std::vector<Entity> entities(count);
+    for (auto _ : state) {
+        for (auto &entity : entities) {
+            entity = coordinator->createEntity();
+        }
+        for (Entity entity : entities) {
+            coordinator->destroyEntity(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_CreateDestroyChurn)->Apply(entityCounts);
+
+/** destroyEntity of entities owning one component, with many registered types */
+void BM_DestroyEntity(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto components = static_cast<std::size_t>(state.range(1));
+    auto coordinator = makeCoordinator(count, components);
+    std::vector<Entity> entities(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (auto &entity : entities) {
+            entity = coordinator->createEntity();
+            ADDERS[0](*coordinator, entity);
+        }
+        state.ResumeTiming();
+        for (Entity entity : entities) {
+            coordinator->destroyEntity(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_DestroyEntity)->Apply(entityAndComponentCounts);
+
+/** addComponent then removeComponent of every registered type on every entity */
+void BM_AddRemoveComponent(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto components = static_cast<std::size_t>(state.range(1));
+    auto coordinator = makeCoordinator(count, components);
+    std::vector<Entity> entities = coordinator->createEntities(count);
+    for (auto _ : state) {
+        for (std::size_t type = 0; type < components; ++type) {
+            for (Entity entity : entities) {
+                ADDERS[type](*coordinator, entity);
+            }
+        }
+        for (std::size_t type = 0; type < components; ++type) {
+            for (Entity entity : entities) {
+                REMOVERS[type](*coordinator, entity);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count * components * 2));
+}
+BENCHMARK(BM_AddRemoveComponent)->Apply(entityAndComponentCounts);
+
+/** addComponent then removeComponent of an empty tag on every entity */
+void BM_AddRemoveTag(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 0);
+    coordinator->registerComponent<Marker>();
+    std::vector<Entity> entities = coordinator->createEntities(count);
+    for (auto _ : state) {
+        for (Entity entity : entities) {
+            coordinator->addComponent(entity, Marker{});
+        }
+        for (Entity entity : entities) {
+            coordinator->removeComponent<Marker>(entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count * 2));
+}
+BENCHMARK(BM_AddRemoveTag)->Apply(entityCounts);
+
+/** getComponent in random entity order */
+void BM_RandomGetComponent(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 1);
+    std::vector<Entity> entities = coordinator->spawn(count, Component<0>{});
+    std::shuffle(entities.begin(), entities.end(), std::mt19937(42));
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (Entity entity : entities) {
+            sum += coordinator->getComponent<Component<0>>(entity).value[0];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_RandomGetComponent)->Apply(entityCounts);
+
+/** getAllEntitiesWith over two types, half of the entities owning both */
+void BM_GetAllEntitiesWith(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 2);
+    std::vector<Entity> entities = coordinator->spawn(count, Component<0>{});
+    for (std::size_t i = 0; i < count; i += 2) {
+        ADDERS[1](*coordinator, entities[i]);
+    }
+    for (auto _ : state) {
+        auto matching = coordinator->getAllEntitiesWith<Component<0>, Component<1>>();
+        benchmark::DoNotOptimize(matching.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_GetAllEntitiesWith)->Apply(entityCounts);
+
+/** Classic system update: iterate System::entities and getComponent each one */
+void BM_SystemIteration(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 2);
+    auto system = coordinator->registerSystem<BenchSystem<0>>();
+    Signature signature;
+    signature.set(coordinator->getComponentTypeID<Component<0>>());
+    signature.set(coordinator->getComponentTypeID<Component<1>>());
+    coordinator->setSystemSignature<BenchSystem<0>>(signature);
+    coordinator->spawn(count, Component<0>{}, Component<1>{{1.0f, 1.0f, 1.0f, 1.0f}});
+    for (auto _ : state) {
+        for (Entity entity : system->entities) {
+            auto &position = coordinator->getComponent<Component<0>>(entity);
+            const auto &velocity = coordinator->getComponent<Component<1>>(entity);
+            position.value[0] += velocity.value[0];
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_SystemIteration)->Apply(entityCounts);
+
+/** The same update written with a view over the packed storages */
+void BM_ViewIteration(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 2);
+    coordinator->spawn(count, Component<0>{}, Component<1>{{1.0f, 1.0f, 1.0f, 1.0f}});
+    for (auto _ : state) {
+        coordinator->view<Component<0>, Component<1>>().each(
+            [](Entity, Component<0> &position, Component<1> &velocity) { position.value[0] += velocity.value[0]; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_ViewIteration)->Apply(entityCounts);
+
+/** view<Changed<T>> after 1% of the entities were changed, one tick per iteration */
+void BM_ChangedView(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 1);
+    coordinator->enableChangeTracking<Component<0>>();
+    std::vector<Entity> entities = coordinator->spawn(count, Component<0>{});
+    for (auto _ : state) {
+        coordinator->advanceTick();
+        for (std::size_t i = 0; i < count; i += 100) {
+            coordinator->markDirty<Component<0>>(entities[i]);
+        }
+        float sum = 0.0f;
+        coordinator->view<Changed<Component<0>>>().each([&sum](Entity, Component<0> &component) {
+            sum += component.value[0];
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_ChangedView)->Apply(entityCounts);
+
+/** Signature changes (add + remove of a component) with many registered systems */
+void BM_SignatureChangedManySystems(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto systems = static_cast<std::size_t>(state.range(1));
+    constexpr std::size_t components = 8;
+    auto coordinator = makeCoordinator(count, components);
+    registerSystems(*coordinator, systems, components, std::make_index_sequence<MAX_BENCH_SYSTEMS>{});
+    std::vector<Entity> entities = coordinator->spawn(count, Component<1>{}, Component<2>{});
+    for (auto _ : state) {
+        for (Entity entity : entities) {
+            ADDERS[0](*coordinator, entity);
+        }
+        for (Entity entity : entities) {
+            REMOVERS[0](*coordinator, entity);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count * 2));
+}
+BENCHMARK(BM_SignatureChangedManySystems)->Apply(entityAndSystemCounts);
+
+/** Particle integration over packed components through a view */
+void BM_IntegratePacked(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 0);
+    coordinator->registerComponent<PackedPosition>();
+    coordinator->registerComponent<PackedVelocity>();
+    coordinator->spawn(count, PackedPosition{}, PackedVelocity{1.0f, 2.0f, 3.0f});
+    for (auto _ : state) {
+        coordinator->view<PackedPosition, PackedVelocity>().each([](Entity, PackedPosition &position, PackedVelocity &velocity) {
+            position.x += velocity.x * 0.016f;
+            position.y += velocity.y * 0.016f;
+            position.z += velocity.z * 0.016f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_IntegratePacked)->Apply(entityCounts);
+
+/** The same integration through an owning group: lockstep walk, no sparse lookup */
+void BM_IntegrateGroup(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 0);
+    coordinator->registerComponent<PackedPosition>();
+    coordinator->registerComponent<PackedVelocity>();
+    coordinator->spawn(count, PackedPosition{}, PackedVelocity{1.0f, 2.0f, 3.0f});
+    auto movers = coordinator->group<PackedPosition, PackedVelocity>();
+    for (auto _ : state) {
+        movers.each([](Entity, PackedPosition &position, PackedVelocity &velocity) {
+            position.x += velocity.x * 0.016f;
+            position.y += velocity.y * 0.016f;
+            position.z += velocity.z * 0.016f;
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_IntegrateGroup)->Apply(entityCounts);
+
+/** The same integration over SoA columns (both storages spawned together, so rows line up) */
+void BM_IntegrateSoA(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto coordinator = makeCoordinator(count, 0);
+    coordinator->registerComponent<SoAPosition>();
+    coordinator->registerComponent<SoAVelocity>();
+    coordinator->spawn(count, SoAPosition{}, SoAVelocity{1.0f, 2.0f, 3.0f});
+    for (auto _ : state) {
+        auto positions = coordinator->columns<SoAPosition>();
+        auto velocities = coordinator->columns<SoAVelocity>();
+        float *px = positions.column<&SoAPosition::x>().data();
+        float *py = positions.column<&SoAPosition::y>().data();
+        float *pz = positions.column<&SoAPosition::z>().data();
+        const float *vx = velocities.column<&SoAVelocity::x>().data();
+        const float *vy = velocities.column<&SoAVelocity::y>().data();
+        const float *vz = velocities.column<&SoAVelocity::z>().data();
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            px[i] += vx[i] * 0.016f;
+            py[i] += vy[i] * 0.016f;
+            pz[i] += vz[i] * 0.016f;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_IntegrateSoA)->Apply(entityCounts);
+
+/** Spinning up a world sharing the 32 component types of a prototype */
+void BM_InitFromPrototype(benchmark::State &state) {
+    auto prototype = makeCoordinator(MAX_ENTITIES, MAX_BENCH_COMPONENTS);
+    Coordinator world;
+    for (auto _ : state) {
+        world.initFrom(*prototype);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InitFromPrototype);
+
+/** cloneWorld of entities owning four components into a reused target */
+void BM_CloneWorld(benchmark::State &state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    auto source = makeCoordinator(count, 4);
+    for (std::size_t i = 0; i < count; ++i) {
+        Entity entity = source->createEntity();
+        for (std::size_t type = 0; type < 4; ++type) {
+            ADDERS[type](*source, entity);
+        }
+    }
+    Coordinator target;
+    target.initFrom(*source);
+    for (auto _ : state) {
+        source->cloneWorld(target);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+BENCHMARK(BM_CloneWorld)->Apply(entityCounts);
+
+/** executeWhenPossible dispatch overhead, every call due, run inline by the scheduler */
+void BM_ExecuteWhenPossible(benchmark::State &state) {
+    BenchSystem<0> system;
+    system.setTPS(60.0f);
+    float sum = 0.0f;
+    for (auto _ : state) {
+        system.executeWhenPossible(1.0f / 60.0f, [&sum](float deltaTime) { sum += deltaTime; },
+                                   [](auto &&job) { job(); });
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecuteWhenPossible);
+
+} // namespace
+
+BENCHMARK_MAIN();
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include "Snapshot.hpp"
 #include "Types.hpp"
 
 /**
@@ -16,4 +20,100 @@ class AComponentStorage
          * @param entity The entity to remove.
          */
         virtual void entityDestroyed(Entity entity) = 0;
+
+        /**
+         * @brief Sets the tick stamped on components added or changed from now on.
+         * @param tick The current tick.
+         */
+        virtual void setCurrentTick(Tick tick) = 0;
+
+        /**
+         * @brief Gets the name identifying the component type in snapshots.
+         * @return The component type name.
+         */
+        virtual const char *typeName() const = 0;
+
+        /**
+         * @brief Checks whether the component type can be stored in a snapshot.
+         * @return True if saveSnapshot() / loadSnapshot() are supported.
+         */
+        virtual bool isSnapshotable() const = 0;
+
+        /**
+         * @brief Checks whether snapshots leave the component type out instead of failing.
+         * @return True for component types that are not saved (Shared<T> handles).
+         */
+        virtual bool isSnapshotSkipped() const = 0;
+
+        /**
+         * @brief Writes the component data to a snapshot.
+         * @param writer The snapshot writer.
+         */
+        virtual void saveSnapshot(SnapshotWriter &writer) const = 0;
+
+        /**
+         * @brief Replaces the component data with the one of a snapshot.
+         * @param reader The snapshot reader.
+         */
+        virtual void loadSnapshot(SnapshotReader &reader) = 0;
+
+        /**
+         * @brief Removes every component.
+         */
+        virtual void clear() = 0;
+
+        /**
+         * @brief Checks if an entity has a component.
+         * @param entity The entity.
+         * @return True if the entity has a component of this type.
+         */
+        virtual bool hasEntity(Entity entity) const = 0;
+
+        /**
+         * @brief Gets the packed slot of the component of an entity.
+         * @param entity The entity, which must own a component of this type.
+         * @return Index into the packed arrays.
+         */
+        virtual std::size_t indexOfEntity(Entity entity) const = 0;
+
+        /**
+         * @brief Exchanges two packed slots, with their entities and ticks.
+         * @param a Packed index.
+         * @param b Packed index.
+         */
+        virtual void swapEntries(std::size_t a, std::size_t b) = 0;
+
+        /**
+         * @brief Gets the number of stored components.
+         * @return Number of entities owning this component.
+         */
+        virtual std::size_t entityCount() const = 0;
+
+        /**
+         * @brief Gets the entity owning a packed slot.
+         * @param index Packed index, below entityCount().
+         * @return The entity.
+         */
+        virtual Entity entityAt(std::size_t index) const = 0;
+
+        /**
+         * @brief Creates an empty storage of the same component type.
+         * @param resource Memory resource backing the new storage.
+         * @return The new storage, with the same change tracking setting.
+         */
+        virtual std::unique_ptr<AComponentStorage> cloneEmpty(std::pmr::memory_resource *resource) const = 0;
+
+        /**
+         * @brief Replaces the content with a copy of another storage of the same type.
+         * @param source The storage to copy.
+         */
+        virtual void copyFrom(const AComponentStorage &source) = 0;
+
+        /**
+         * @brief Moves the component of an entity into another storage of the same type.
+         * @param entity The entity, which must own a component of this type.
+         * @param destination The storage receiving the component.
+         * @param target The entity owning the component in destination.
+         */
+        virtual void transferEntity(Entity entity, AComponentStorage &destination, Entity target) = 0;
 };
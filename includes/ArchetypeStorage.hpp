@@ -0,0 +1,584 @@
+/**
+ * @file ArchetypeStorage.hpp
+ * @brief Archetype/chunk based component storage for the ECS framework
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "Tag.hpp"
+#include "Types.hpp"
+
+/**
+ * @struct ComponentInfo
+ * @brief Type-erased description of a component type, used to move data between chunks
+ */
+struct ComponentInfo {
+    /** sizeof(T) */
+    std::size_t size = 0;
+
+    /** alignof(T) */
+    std::size_t align = 1;
+
+    /** Move-constructs a T at dst from src */
+    void (*moveConstruct)(void *dst, void *src) = nullptr;
+
+    /** Destroys the T at ptr */
+    void (*destroy)(void *ptr) = nullptr;
+
+    /** True for tags (see isTag), which get no column */
+    bool tag = false;
+
+    /**
+     * @brief Builds the description of a component type
+     * @tparam T Component type
+     */
+    template <typename T>
+    static ComponentInfo of() {
+        ComponentInfo info;
+        info.tag = isTag<T>;
+        info.size = sizeof(T);
+        info.align = alignof(T);
+        info.moveConstruct = [](void *dst, void *src) { new (dst) T(std::move(*static_cast<T *>(src))); };
+        info.destroy = [](void *ptr) { static_cast<T *>(ptr)->~T(); };
+        return info;
+    }
+};
+
+/**
+ * @class Chunk
+ * @brief Fixed-size block of memory holding a group of entities of one archetype
+ *
+ * The chunk starts with the entity column, followed by one column (array) per
+ * component type of the archetype (structure of arrays). Column offsets are owned
+ * by the Archetype. Tags have no column: they only exist in the archetype signature.
+ */
+class Chunk {
+public:
+    /** Size in bytes of every chunk */
+    static constexpr std::size_t SIZE = 16 * 1024;
+
+    /** Alignment of the chunk memory, and maximum supported component alignment */
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    /**
+     * @brief Gets the number of entities stored in the chunk
+     * @return Entity count
+     */
+    std::size_t size() const { return _count; }
+
+    /**
+     * @brief Gets the entity column
+     * @return Pointer to size() entities
+     */
+    const Entity *entities() const { return reinterpret_cast<const Entity *>(_bytes); }
+
+    /**
+     * @brief Gets the raw chunk memory
+     * @return Pointer to the first byte of the chunk
+     */
+    std::byte *bytes() { return _bytes; }
+
+private:
+    friend class Archetype;
+
+    alignas(ALIGNMENT) std::byte _bytes[SIZE];
+    std::size_t _count = 0;
+};
+
+/**
+ * @class Archetype
+ * @brief Group of every entity sharing the exact same Signature
+ *
+ * Entities are packed into chunks: all chunks but the last are full, and removals
+ * move the very last entity into the freed row, so iteration never meets holes.
+ */
+class Archetype {
+public:
+    /**
+     * @brief Builds the archetype and its chunk layout
+     * @param signature Components owned by every entity of the archetype
+     * @param infos Descriptions of every registered component type
+     * @throws std::length_error if a single entity does not fit in a chunk
+     */
+    Archetype(Signature signature, const std::array<ComponentInfo, MAX_COMPONENTS> &infos)
+        : _signature(signature) {
+        _columnOf.fill(NO_COLUMN);
+        _addEdges.fill(nullptr);
+        _removeEdges.fill(nullptr);
+
+        std::size_t rowSize = sizeof(Entity);
+        for (std::size_t id = 0; id < MAX_COMPONENTS; ++id) {
+            if (signature.test(id) && !infos[id].tag) {
+                if (infos[id].align > Chunk::ALIGNMENT) {
+                    throw std::length_error("Archetype: component alignment exceeds chunk alignment.");
+                }
+                _columnOf[id] = static_cast<std::uint8_t>(_types.size());
+                _types.push_back(static_cast<ComponentTypeID>(id));
+                _infos.push_back(infos[id]);
+                rowSize += infos[id].size;
+            }
+        }
+
+        _offsets.resize(_types.size());
+        for (_capacity = Chunk::SIZE / rowSize; _capacity > 0; --_capacity) {
+            std::size_t offset = _capacity * sizeof(Entity);
+            for (std::size_t column = 0; column < _types.size(); ++column) {
+                std::size_t align = _infos[column].align;
+                offset = (offset + align - 1) / align * align;
+                _offsets[column] = offset;
+                offset += _capacity * _infos[column].size;
+            }
+            if (offset <= Chunk::SIZE) {
+                break;
+            }
+        }
+        if (_capacity == 0) {
+            throw std::length_error("Archetype: an entity of this archetype does not fit in a chunk.");
+        }
+    }
+
+    ~Archetype() {
+        for (auto &chunk : _chunks) {
+            for (std::size_t row = 0; row < chunk->_count; ++row) {
+                for (std::size_t column = 0; column < _types.size(); ++column) {
+                    _infos[column].destroy(cell(*chunk, column, row));
+                }
+            }
+        }
+    }
+
+    Archetype(const Archetype &) = delete;
+    Archetype &operator=(const Archetype &) = delete;
+
+    /**
+     * @brief Gets the signature shared by every entity of the archetype
+     * @return Archetype signature
+     */
+    const Signature &getSignature() const { return _signature; }
+
+    /**
+     * @brief Gets the number of entities in the archetype
+     * @return Entity count across all chunks
+     */
+    std::size_t size() const {
+        return _chunks.empty() ? 0 : (_chunks.size() - 1) * _capacity + _chunks.back()->_count;
+    }
+
+    /**
+     * @brief Gets the number of entities a chunk of this archetype can hold
+     * @return Rows per chunk
+     */
+    std::size_t chunkCapacity() const { return _capacity; }
+
+    /**
+     * @brief Gets the number of chunks in use
+     * @return Chunk count
+     */
+    std::size_t chunkCount() const { return _chunks.size(); }
+
+    /**
+     * @brief Gets a chunk by index
+     * @param index Chunk index, lower than chunkCount()
+     * @return Reference to the chunk
+     */
+    Chunk &getChunk(std::size_t index) { return *_chunks[index]; }
+
+    /**
+     * @brief Checks if the archetype stores a component type
+     * @param type Component type ID
+     * @return True if the type is part of the archetype (with a column, unless it is a tag)
+     */
+    bool hasColumn(ComponentTypeID type) const { return _signature.test(type); }
+
+    /**
+     * @brief Gets the column of a component type inside a chunk
+     * @tparam T Component type
+     * @param chunk Chunk of this archetype
+     * @param type Component type ID of T, which must be part of the archetype
+     * @return Pointer to chunk.size() contiguous components, or for a tag to the single
+     *         tagInstance<T>() (not an array: every row refers to it)
+     */
+    template <typename T>
+    T *column(Chunk &chunk, ComponentTypeID type) {
+        if constexpr (isTag<T>) {
+            (void)chunk;
+            (void)type;
+            return &tagInstance<T>();
+        } else {
+            return reinterpret_cast<T *>(chunk._bytes + _offsets[_columnOf[type]]);
+        }
+    }
+
+    /**
+     * @brief Gets the component of a row
+     * @tparam T Component type
+     * @param chunk Chunk of this archetype
+     * @param type Component type ID of T, which must be part of the archetype
+     * @param row Row inside the chunk
+     * @return Reference to the component (tagInstance<T>() for a tag)
+     */
+    template <typename T>
+    T &at(Chunk &chunk, ComponentTypeID type, std::size_t row) {
+        if constexpr (isTag<T>) {
+            (void)row;
+            return *column<T>(chunk, type);
+        } else {
+            return column<T>(chunk, type)[row];
+        }
+    }
+
+private:
+    friend class ArchetypeStorage;
+
+    /** Marker for a component type without a column */
+    static constexpr std::uint8_t NO_COLUMN = 0xFF;
+
+    Signature _signature;
+    std::size_t _capacity = 0;
+
+    /** Component types of the archetype, in ascending ID order */
+    std::vector<ComponentTypeID> _types;
+
+    /** Description of each column */
+    std::vector<ComponentInfo> _infos;
+
+    /** Byte offset of each column inside a chunk */
+    std::vector<std::size_t> _offsets;
+
+    /** Component type ID to column index */
+    std::array<std::uint8_t, MAX_COMPONENTS> _columnOf{};
+
+    /** Cached archetype reached by adding / removing a component type */
+    std::array<Archetype *, MAX_COMPONENTS> _addEdges{};
+    std::array<Archetype *, MAX_COMPONENTS> _removeEdges{};
+
+    std::vector<std::unique_ptr<Chunk>> _chunks;
+
+    void *cell(Chunk &chunk, std::size_t column, std::size_t row) {
+        return chunk._bytes + _offsets[column] + row * _infos[column].size;
+    }
+
+    /**
+     * @brief Appends a row for an entity, components left uninitialized
+     * @return Chunk index and row of the new slot
+     */
+    std::pair<std::size_t, std::size_t> allocateRow(Entity entity) {
+        if (_chunks.empty() || _chunks.back()->_count == _capacity) {
+            _chunks.emplace_back(new Chunk);
+        }
+        Chunk &chunk = *_chunks.back();
+        std::size_t row = chunk._count++;
+        reinterpret_cast<Entity *>(chunk._bytes)[row] = entity;
+        return {_chunks.size() - 1, row};
+    }
+
+    /**
+     * @brief Frees a row whose components were already moved out or destroyed
+     * @param chunkIndex Chunk of the row
+     * @param row Row to free
+     * @param moved Set to the entity moved into the freed row, if any
+     * @return True if an entity was moved into the freed row
+     */
+    bool eraseRow(std::size_t chunkIndex, std::size_t row, Entity &moved) {
+        Chunk &last = *_chunks.back();
+        std::size_t lastRow = last._count - 1;
+        bool relocated = false;
+
+        if (chunkIndex != _chunks.size() - 1 || row != lastRow) {
+            Chunk &chunk = *_chunks[chunkIndex];
+            for (std::size_t column = 0; column < _types.size(); ++column) {
+                void *source = cell(last, column, lastRow);
+                _infos[column].moveConstruct(cell(chunk, column, row), source);
+                _infos[column].destroy(source);
+            }
+            moved = reinterpret_cast<Entity *>(last._bytes)[lastRow];
+            reinterpret_cast<Entity *>(chunk._bytes)[row] = moved;
+            relocated = true;
+        }
+        if (--last._count == 0) {
+            _chunks.pop_back();
+        }
+        return relocated;
+    }
+};
+
+/**
+ * @class ArchetypeStorage
+ * @brief Stores every component of every entity grouped by archetype
+ *
+ * Alternative to the per-type ComponentStorage sparse sets: all entities with an
+ * identical Signature live together in 16 KiB chunks with one column per component,
+ * so systems touching several components stream through contiguous memory. Adding or
+ * removing a component moves the entity (and its data) to another archetype.
+ */
+class ArchetypeStorage {
+public:
+    /**
+     * @brief Registers a component type
+     * @tparam T Component type
+     * @param type Component type ID assigned to T
+     */
+    template <typename T>
+    void registerComponent(ComponentTypeID type) {
+        _infos[type] = ComponentInfo::of<T>();
+    }
+
+    /**
+     * @brief Registers a component type already registered in another storage
+     * @param other Storage the type information is copied from
+     * @param type Component type ID registered in other
+     */
+    void registerComponentFrom(const ArchetypeStorage &other, ComponentTypeID type) {
+        _infos[type] = other._infos[type];
+    }
+
+    /**
+     * @brief Adds a component to an entity, moving it to the matching archetype
+     * @tparam T Component type
+     * @param entity The entity
+     * @param type Component type ID of T
+     * @param component The component data
+     *
+     * If the entity already owns a component of this type, the existing data is kept.
+     */
+    template <typename T>
+    void insertData(Entity entity, ComponentTypeID type, T component) {
+        emplaceData<T>(entity, type, std::move(component));
+    }
+
+    /**
+     * @brief Constructs a component of an entity in place, moving it to the matching archetype
+     * @tparam T Component type
+     * @param entity The entity
+     * @param type Component type ID of T
+     * @param args Arguments forwarded to the constructor of T
+     * @return Reference to the new component, or to the existing one if the entity
+     *         already owns a component of this type
+     */
+    template <typename T, typename... Args>
+    T &emplaceData(Entity entity, ComponentTypeID type, Args &&...args) {
+        if constexpr (!std::is_nothrow_constructible_v<T, Args &&...> && std::is_nothrow_move_constructible_v<T>) {
+            // Build the component first so a throwing constructor leaves the entity untouched
+            if (!hasData(entity, type)) {
+                return emplaceData<T>(entity, type, makeComponent<T>(std::forward<Args>(args)...));
+            }
+        }
+        Location &location = locate(entity);
+        if (location.archetype && location.archetype->hasColumn(type)) {
+            return location.archetype->at<T>(location.archetype->getChunk(location.chunk), type, location.row);
+        }
+        Archetype *target = location.archetype ? location.archetype->_addEdges[type] : nullptr;
+        if (!target) {
+            Signature signature = location.archetype ? location.archetype->getSignature() : Signature{};
+            target = &getOrCreate(signature.set(type));
+            if (location.archetype) {
+                location.archetype->_addEdges[type] = target;
+            }
+        }
+        moveEntity(entity, *target);
+        Location &moved = _locations[entityIndex(entity)];
+        if constexpr (isTag<T>) {
+            // No column: joining the archetype is the whole insertion
+            return target->at<T>(target->getChunk(moved.chunk), type, moved.row);
+        } else {
+            T *cell = target->column<T>(target->getChunk(moved.chunk), type) + moved.row;
+            if constexpr (std::is_constructible_v<T, Args &&...>) {
+                return *new (cell) T(std::forward<Args>(args)...);
+            } else {
+                return *new (cell) T{std::forward<Args>(args)...};
+            }
+        }
+    }
+
+    /**
+     * @brief Builds a component from constructor arguments (brace-initialized for aggregates)
+     */
+    template <typename T, typename... Args>
+    static T makeComponent(Args &&...args) {
+        if constexpr (std::is_constructible_v<T, Args &&...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+
+    /**
+     * @brief Removes a component from an entity, moving it to the matching archetype
+     * @param entity The entity
+     * @param type Component type ID to remove
+     */
+    void removeData(Entity entity, ComponentTypeID type) {
+        if (!hasData(entity, type)) {
+            return;
+        }
+        Archetype *source = _locations[entityIndex(entity)].archetype;
+        Archetype *target = source->_removeEdges[type];
+        if (!target) {
+            Signature signature = source->getSignature();
+            signature.reset(type);
+            target = signature.none() ? nullptr : &getOrCreate(signature);
+            source->_removeEdges[type] = target;
+        }
+        if (target) {
+            moveEntity(entity, *target);
+        } else {
+            entityDestroyed(entity);
+        }
+    }
+
+    /**
+     * @brief Retrieves component data for an entity
+     * @tparam T Component type
+     * @param entity The entity
+     * @param type Component type ID of T
+     * @return Reference to the component data
+     * @throws std::out_of_range if the entity has no such component
+     */
+    template <typename T>
+    T &getData(Entity entity, ComponentTypeID type) {
+        if (!hasData(entity, type)) {
+            throw std::out_of_range("ArchetypeStorage::getData: entity has no such component.");
+        }
+        const Location &location = _locations[entityIndex(entity)];
+        return location.archetype->at<T>(location.archetype->getChunk(location.chunk), type, location.row);
+    }
+
+    /**
+     * @brief Checks if an entity has a component
+     * @param entity The entity
+     * @param type Component type ID
+     * @return True if the entity has the component
+     */
+    bool hasData(Entity entity, ComponentTypeID type) const {
+        Entity index = entityIndex(entity);
+        return index < _locations.size() && _locations[index].entity == entity &&
+               _locations[index].archetype && _locations[index].archetype->hasColumn(type);
+    }
+
+    /**
+     * @brief Destroys every component of an entity
+     * @param entity The destroyed entity
+     */
+    void entityDestroyed(Entity entity) {
+        Entity index = entityIndex(entity);
+        if (index >= _locations.size() || _locations[index].entity != entity || !_locations[index].archetype) {
+            return;
+        }
+        Location location = _locations[index];
+        Archetype &archetype = *location.archetype;
+        Chunk &chunk = archetype.getChunk(location.chunk);
+
+        for (std::size_t column = 0; column < archetype._types.size(); ++column) {
+            archetype._infos[column].destroy(archetype.cell(chunk, column, location.row));
+        }
+        release(location);
+        _locations[index] = Location{};
+    }
+
+    /**
+     * @brief Gets every archetype created so far
+     * @return Archetypes in creation order
+     */
+    const std::vector<Archetype *> &getArchetypes() const { return _ordered; }
+
+    /**
+     * @brief Sets the callback invoked whenever a new archetype is created
+     * @param callback Function receiving the new archetype
+     */
+    void setArchetypeCreatedCallback(std::function<void(Archetype &)> callback) {
+        _onArchetypeCreated = std::move(callback);
+    }
+
+private:
+    /**
+     * @struct Location
+     * @brief Where the components of an entity live
+     */
+    struct Location {
+        Entity entity = NULL_ENTITY;
+        Archetype *archetype = nullptr;
+        std::size_t chunk = 0;
+        std::size_t row = 0;
+    };
+
+    std::array<ComponentInfo, MAX_COMPONENTS> _infos{};
+    std::unordered_map<Signature, std::unique_ptr<Archetype>> _archetypes;
+    std::vector<Archetype *> _ordered;
+    std::vector<Location> _locations;
+    std::function<void(Archetype &)> _onArchetypeCreated;
+
+    Location &locate(Entity entity) {
+        Entity index = entityIndex(entity);
+        if (index >= _locations.size()) {
+            _locations.resize(static_cast<std::size_t>(index) + 1);
+        }
+        Location &location = _locations[index];
+        if (location.entity != entity) {
+            location = Location{};
+            location.entity = entity;
+        }
+        return location;
+    }
+
+    Archetype &getOrCreate(const Signature &signature) {
+        auto it = _archetypes.find(signature);
+        if (it != _archetypes.end()) {
+            return *it->second;
+        }
+        auto archetype = std::make_unique<Archetype>(signature, _infos);
+        Archetype &created = *archetype;
+        _archetypes.emplace(signature, std::move(archetype));
+        _ordered.push_back(&created);
+        if (_onArchetypeCreated) {
+            _onArchetypeCreated(created);
+        }
+        return created;
+    }
+
+    /**
+     * @brief Frees the row at a location, fixing the entity moved into it
+     */
+    void release(const Location &location) {
+        Entity moved = 0;
+        if (location.archetype->eraseRow(location.chunk, location.row, moved)) {
+            _locations[entityIndex(moved)].chunk = location.chunk;
+            _locations[entityIndex(moved)].row = location.row;
+        }
+    }
+
+    /**
+     * @brief Moves an entity and the components both archetypes share to another archetype
+     *
+     * Components missing from the target are destroyed; components missing from the
+     * source are left uninitialized for the caller to construct.
+     */
+    void moveEntity(Entity entity, Archetype &target) {
+        Location source = _locations[entityIndex(entity)];
+        auto [chunkIndex, row] = target.allocateRow(entity);
+        Chunk &targetChunk = target.getChunk(chunkIndex);
+
+        if (source.archetype) {
+            Archetype &from = *source.archetype;
+            Chunk &sourceChunk = from.getChunk(source.chunk);
+            for (std::size_t column = 0; column < from._types.size(); ++column) {
+                ComponentTypeID type = from._types[column];
+                void *data = from.cell(sourceChunk, column, source.row);
+                if (target.hasColumn(type)) {
+                    from._infos[column].moveConstruct(target.cell(targetChunk, target._columnOf[type], row), data);
+                }
+                from._infos[column].destroy(data);
+            }
+            release(source);
+        }
+        _locations[entityIndex(entity)] = Location{entity, &target, chunkIndex, row};
+    }
+};
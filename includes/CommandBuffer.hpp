@@ -0,0 +1,229 @@
+/**
+ * @file CommandBuffer.hpp
+ * @brief Deferred structural command recording for the ECS framework
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "InplaceTask.hpp"
+#include "Types.hpp"
+
+/**
+ * @class CommandBuffer
+ * @brief Records structural changes (add/remove component, destroy entity) for later application
+ *
+ * Commands are recorded into one of several shards, each with its own small lock.
+ * A thread always records into the same shard, so threads running different systems
+ * rarely contend with each other and never touch the coordinator's global mutex.
+ * A global sequence number keeps the original recording order across shards.
+ *
+ * drain() collects every shard in one pass and coalesces redundant commands:
+ *   - an addComponent followed by a removeComponent of the same type on the same
+ *     entity collapses into the removal,
+ *   - repeated removals of the same type on the same entity collapse into one,
+ *   - a destroyEntity discards every other pending command on that entity.
+ * Batch commands, recorded with NULL_ENTITY, are never coalesced.
+ */
+class CommandBuffer {
+public:
+    /**
+     * @enum CommandType
+     * @brief Kind of structural change carried by a command
+     */
+    enum class CommandType : std::uint8_t {
+        AddComponent,
+        RemoveComponent,
+        DestroyEntity
+    };
+
+    /**
+     * @struct Command
+     * @brief A single recorded structural change
+     */
+    struct Command {
+        /** Kind of change */
+        CommandType type;
+
+        /** Entity targeted by the change (NULL_ENTITY for a batch over several entities) */
+        Entity entity;
+
+        /** Component type affected (unused for DestroyEntity) */
+        ComponentTypeID component;
+
+        /** Global recording order */
+        std::uint64_t sequence;
+
+        /** Applies the change, called with the coordinator lock held (move-only, so it may own move-only components) */
+        InplaceTask apply;
+    };
+
+    /**
+     * @brief Records a command
+     * @param type Kind of change
+     * @param entity Entity targeted by the change
+     * @param component Component type affected (ignored for DestroyEntity)
+     * @param apply Callable applying the change
+     *
+     * Thread-safe. Only the calling thread's shard is locked.
+     */
+    void push(CommandType type, Entity entity, ComponentTypeID component, InplaceTask apply) {
+        Shard &shard = shards[shardIndex()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.commands.push_back({type, entity, component,
+                                  nextSequence.fetch_add(1, std::memory_order_relaxed),
+                                  std::move(apply)});
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of recorded, not yet drained commands
+     * @return Pending command count (before coalescing)
+     */
+    std::size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Takes every recorded command, in recording order, with redundant ones removed
+     * @return Commands ready to be applied
+     */
+    std::vector<Command> drain() {
+        std::vector<Command> collected;
+
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.commands.empty()) {
+                continue;
+            }
+            count.fetch_sub(shard.commands.size(), std::memory_order_relaxed);
+            if (collected.empty()) {
+                collected.swap(shard.commands);
+            } else {
+                collected.insert(collected.end(),
+                                 std::make_move_iterator(shard.commands.begin()),
+                                 std::make_move_iterator(shard.commands.end()));
+                shard.commands.clear();
+            }
+        }
+        std::sort(collected.begin(), collected.end(), [](const Command &a, const Command &b) {
+            return a.sequence < b.sequence;
+        });
+        return coalesce(std::move(collected));
+    }
+
+    /**
+     * @brief Puts drained commands back, ahead of every command recorded since
+     * @param commands Commands returned by drain()
+     * @param first Index of the first command to put back; the ones before it are discarded
+     *
+     * The commands keep their sequence numbers, so the next drain() returns them first,
+     * in their original order. Thread-safe.
+     */
+    void requeue(std::vector<Command> &commands, std::size_t first) {
+        if (first >= commands.size()) {
+            return;
+        }
+        Shard &shard = shards[shardIndex()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.commands.insert(shard.commands.end(),
+                              std::make_move_iterator(commands.begin() + static_cast<std::ptrdiff_t>(first)),
+                              std::make_move_iterator(commands.end()));
+        count.fetch_add(commands.size() - first, std::memory_order_relaxed);
+    }
+
+private:
+    /** Number of independent recording shards */
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    /**
+     * @struct Shard
+     * @brief Recording queue owned by a subset of threads
+     */
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<Command> commands;
+    };
+
+    /** Recording shards */
+    std::array<Shard, SHARD_COUNT> shards{};
+
+    /** Next global sequence number */
+    std::atomic<std::uint64_t> nextSequence{0};
+
+    /** Number of recorded commands across all shards */
+    std::atomic<std::size_t> count{0};
+
+    /**
+     * @brief Gets the shard used by the calling thread
+     * @return Shard index, stable for the lifetime of the thread
+     */
+    static std::size_t shardIndex() {
+        thread_local const std::size_t index =
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) % SHARD_COUNT;
+        return index;
+    }
+
+    /**
+     * @brief Builds a lookup key from an entity and a component type
+     */
+    static std::uint64_t key(Entity entity, ComponentTypeID component) {
+        return (static_cast<std::uint64_t>(entity) << 8) | component;
+    }
+
+    /**
+     * @brief Removes redundant commands from an ordered command list
+     * @param commands Commands sorted by sequence
+     * @return Commands that still have an effect, in the same order
+     */
+    static std::vector<Command> coalesce(std::vector<Command> commands) {
+        if (commands.size() < 2) {
+            return commands;
+        }
+        std::vector<bool> dropped(commands.size(), false);
+        std::unordered_map<Entity, std::size_t> destroyed;
+        std::unordered_map<std::uint64_t, std::size_t> lastKept;
+
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            if (commands[i].type == CommandType::DestroyEntity) {
+                if (!destroyed.insert({commands[i].entity, i}).second) {
+                    dropped[i] = true;
+                }
+            }
+        }
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            const Command &command = commands[i];
+
+            if (command.type == CommandType::DestroyEntity || command.entity == NULL_ENTITY) {
+                continue;
+            }
+            if (destroyed.count(command.entity)) {
+                dropped[i] = true;
+                continue;
+            }
+            auto k = key(command.entity, command.component);
+            auto previous = lastKept.find(k);
+            if (command.type == CommandType::RemoveComponent && previous != lastKept.end()) {
+                dropped[previous->second] = true;
+            }
+            lastKept[k] = i;
+        }
+
+        std::vector<Command> result;
+        result.reserve(commands.size());
+        for (std::size_t i = 0; i < commands.size(); ++i) {
+            if (!dropped[i]) {
+                result.push_back(std::move(commands[i]));
+            }
+        }
+        return result;
+    }
+};
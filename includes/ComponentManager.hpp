@@ -1,33 +1,101 @@
 #pragma once
 
-#include <unordered_map>
-#include <typeindex>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <typeinfo>
 #include <memory>
+#include <memory_resource>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 #include "AComponentStorage.hpp"
+#include "ArchetypeStorage.hpp"
 #include "ComponentStorage.hpp"
+#include "ComponentType.hpp"
+#include "EntityManager.hpp"
+#include "Group.hpp"
+#include "Snapshot.hpp"
 #include "Types.hpp"
 
 /**
  * @class ComponentManager
  * @brief Manages component arrays and types.
+ *
+ * Component type IDs come from ComponentType::id<T>(), so finding the storage of a
+ * type is a flat array index: no hashing and no reference counting.
  */
 class ComponentManager
 {
     public:
+        /**
+         * @brief Creates a component manager.
+         * @param mode Storage backend used for component data.
+         * @param resource Memory resource backing the sparse-set storages.
+         */
+        explicit ComponentManager(StorageMode mode = StorageMode::SparseSet,
+                                  std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : storageMode(mode), memoryResource(resource) {}
+
         /**
          * @brief Registers a component type.
          * @tparam T Component type.
+         *
+         * Prints the assigned ID only when built with ECS_VERBOSE.
          */
         template <typename T>
         void registerComponent()
         {
-            std::type_index typeName = typeid(T);
+            ComponentTypeID type = ComponentType::id<T>();
 
-            componentTypes.insert({typeName, nextComponentType});
-            ComponentStorages.insert({typeName, std::make_shared<ComponentStorage<T>>()});
-            printf("Registering component type %d - (%s)\n", nextComponentType, typeName.name());
-            nextComponentType++;
+            if (registeredTypes.test(type)) {
+                return;
+            }
+            registeredTypes.set(type);
+            if (storageMode == StorageMode::Archetype) {
+                archetypeStorage.registerComponent<T>(type);
+            } else {
+                componentStorages[type] = std::make_unique<ComponentStorage<T>>(memoryResource);
+                componentStorages[type]->setCurrentTick(currentTick);
+            }
+#if ECS_VERBOSE
+            std::printf("Registering component type %d - (%s)\n", type, typeid(T).name());
+#endif
+        }
+
+        /**
+         * @brief Registers every component type registered in another manager.
+         * @param prototype Manager whose registrations are copied.
+         * @throws std::logic_error if the storage modes differ.
+         *
+         * Storages are created empty, with the change tracking setting of the
+         * prototype, and nothing is printed.
+         */
+        void registerComponentsOf(const ComponentManager &prototype)
+        {
+            if (prototype.storageMode != storageMode) {
+                throw std::logic_error("Component registrations can only be shared between worlds of the same storage mode.");
+            }
+            forEachSetBit(prototype.registeredTypes & ~registeredTypes, [&](ComponentTypeID type) {
+                if (storageMode == StorageMode::Archetype) {
+                    archetypeStorage.registerComponentFrom(prototype.archetypeStorage, type);
+                } else {
+                    componentStorages[type] = prototype.componentStorages[type]->cloneEmpty(memoryResource);
+                    componentStorages[type]->setCurrentTick(currentTick);
+                }
+            });
+            registeredTypes |= prototype.registeredTypes;
+        }
+
+        /**
+         * @brief Gets the registered component types.
+         * @return Signature with the bit of every registered type set.
+         */
+        const Signature& getRegisteredTypes() const
+        {
+            return registeredTypes;
         }
 
         /**
@@ -36,10 +104,9 @@ class ComponentManager
          * @return The component type ID.
          */
         template <typename T>
-        ComponentTypeID getComponentTypeID()
+        ComponentTypeID getComponentTypeID() const
         {
-            std::type_index typeName = typeid(T);
-            return componentTypes[typeName];
+            return ComponentType::id<T>();
         }
 
         /**
@@ -51,7 +118,30 @@ class ComponentManager
         template <typename T>
         void addComponent(Entity entity, T component)
         {
-            GetComponentStorage<T>()->insertData(entity, component);
+            emplaceComponent<T>(entity, std::move(component));
+        }
+
+        /**
+         * @brief Constructs a component of an entity in place.
+         * @tparam T Component type.
+         * @param entity The entity.
+         * @param args Arguments forwarded to the constructor of T.
+         * @return Reference to the new component, or to the existing one if the entity
+         *         already owns a component of this type.
+         */
+        template <typename T, typename... Args>
+        ComponentRef<T> emplaceComponent(Entity entity, Args&&... args)
+        {
+            if (storageMode == StorageMode::Archetype) {
+                return archetypeStorage.emplaceData<T>(entity, getComponentTypeID<T>(), std::forward<Args>(args)...);
+            }
+            ComponentStorage<T>* storage = GetComponentStorage<T>();
+            if (GroupData *group = groupOf[ComponentType::id<T>()]) {
+                storage->emplaceData(entity, std::forward<Args>(args)...);
+                group->tryJoin(entity);
+                return storage->getDataUnchecked(entity);
+            }
+            return storage->emplaceData(entity, std::forward<Args>(args)...);
         }
 
         /**
@@ -62,48 +152,446 @@ class ComponentManager
         template <typename T>
         void removeComponent(Entity entity)
         {
-            GetComponentStorage<T>()->removeData(entity);
+            if (storageMode == StorageMode::Archetype) {
+                archetypeStorage.removeData(entity, getComponentTypeID<T>());
+                return;
+            }
+            ComponentStorage<T>* storage = GetComponentStorage<T>();
+            if (GroupData *group = groupOf[ComponentType::id<T>()]) {
+                group->leave(entity);
+            }
+            storage->removeData(entity);
         }
 
         /**
          * @brief Gets a component from an entity.
          * @tparam T Component type.
          * @param entity The entity.
-         * @return Reference to the component data.
+         * @return Reference to the component data (a SoARef for SoA components; in archetype
+         *         mode SoA components stay whole inside their chunk and the proxy points there).
          */
         template <typename T>
-        T& getComponent(Entity entity)
+        ComponentRef<T> getComponent(Entity entity)
         {
+            if (storageMode == StorageMode::Archetype) {
+                return archetypeStorage.getData<T>(entity, getComponentTypeID<T>());
+            }
             return GetComponentStorage<T>()->getData(entity);
         }
 
+        /**
+         * @brief Gets a component from an entity for writing.
+         * @tparam T Component type.
+         * @param entity The entity.
+         * @return Reference to the component data, marked as changed at the current tick
+         *         when the storage tracks changes.
+         */
+        template <typename T>
+        ComponentRef<T> getComponentMut(Entity entity)
+        {
+            if (storageMode == StorageMode::Archetype) {
+                return archetypeStorage.getData<T>(entity, getComponentTypeID<T>());
+            }
+            return GetComponentStorage<T>()->getDataMut(entity);
+        }
+
+        /**
+         * @brief Marks the component of an entity as changed at the current tick.
+         * @tparam T Component type.
+         * @param entity The entity (ignored if it has no such component).
+         */
+        template <typename T>
+        void markChanged(Entity entity)
+        {
+            if (storageMode == StorageMode::Archetype) {
+                return;
+            }
+            GetComponentStorage<T>()->markChanged(entity);
+        }
+
         /**
          * @brief Called when an entity is destroyed.
          * @param entity The destroyed entity.
          */
         void entityDestroyed(Entity entity)
         {
-            for (auto const& pair : ComponentStorages)
+            if (storageMode == StorageMode::Archetype) {
+                archetypeStorage.entityDestroyed(entity);
+                return;
+            }
+            for (auto const& group : groups)
+            {
+                group->leave(entity);
+            }
+            for (auto const& storage : componentStorages)
+            {
+                if (storage) {
+                    storage->entityDestroyed(entity);
+                }
+            }
+        }
+
+        /**
+         * @brief Called when an entity is destroyed, visiting only the storages it uses.
+         * @param entity The destroyed entity.
+         * @param signature The entity's signature before destruction.
+         */
+        void entityDestroyed(Entity entity, const Signature& signature)
+        {
+            if (storageMode == StorageMode::Archetype) {
+                archetypeStorage.entityDestroyed(entity);
+                return;
+            }
+            forEachSetBit(signature, [&](ComponentTypeID type) {
+                if (GroupData *group = groupOf[type]) {
+                    group->leave(entity);
+                }
+                if (auto const& storage = componentStorages[type]) {
+                    storage->entityDestroyed(entity);
+                }
+            });
+        }
+
+        /**
+         * @brief Creates (or finds) the owning group of a set of component types.
+         * @tparam Ts Component types owned by the group.
+         * @return Handle over the group, valid as long as this manager.
+         * @throws std::logic_error in archetype storage mode, or if one of Ts... is
+         *         already owned by a different group.
+         * @throws std::out_of_range if a component type is not registered.
+         *
+         * The entities already owning every one of Ts... join the group right away.
+         */
+        template <typename... Ts>
+        Group<Ts...> group()
+        {
+            if (storageMode == StorageMode::Archetype) {
+                throw std::logic_error("Groups require sparse-set storage.");
+            }
+            auto storages = std::make_tuple(static_cast<BasicComponentStorage<Ts>*>(GetComponentStorage<Ts>())...);
+            Signature owned;
+            (owned.set(ComponentType::id<Ts>()), ...);
+            if (owned.count() != sizeof...(Ts)) {
+                throw std::logic_error("A group cannot own the same component type twice.");
+            }
+
+            for (auto const& existing : groups)
+            {
+                if (existing->owned == owned) {
+                    return Group<Ts...>(storages, existing.get());
+                }
+                if (existing->owned.intersects(owned)) {
+                    throw std::logic_error("A component type can be owned by only one group.");
+                }
+            }
+            auto data = std::make_unique<GroupData>();
+            data->owned = owned;
+            data->storages = {componentStorages[ComponentType::id<Ts>()].get()...};
+            data->rebuild();
+            ((groupOf[ComponentType::id<Ts>()] = data.get()), ...);
+            groups.push_back(std::move(data));
+            return Group<Ts...>(storages, groups.back().get());
+        }
+
+        /**
+         * @brief Replaces the content of every storage with a copy of another manager's.
+         * @param source Manager to copy; its types missing here are registered first.
+         * @throws std::logic_error in archetype storage mode, or if a component type
+         *         is not copyable.
+         *
+         * Each storage is copied as whole arrays into the arrays already allocated
+         * here. Types registered only here are emptied, and groups are rebuilt.
+         */
+        void copyFrom(const ComponentManager &source)
+        {
+            if (storageMode == StorageMode::Archetype || source.storageMode == StorageMode::Archetype) {
+                throw std::logic_error("Cloning requires sparse-set storage.");
+            }
+            registerComponentsOf(source);
+            currentTick = source.currentTick;
+            for (std::size_t type = 0; type < componentStorages.size(); ++type)
+            {
+                if (!componentStorages[type]) {
+                    continue;
+                }
+                if (source.componentStorages[type]) {
+                    componentStorages[type]->copyFrom(*source.componentStorages[type]);
+                } else {
+                    componentStorages[type]->clear();
+                    componentStorages[type]->setCurrentTick(currentTick);
+                }
+            }
+            for (auto const& group : groups)
+            {
+                group->rebuild();
+            }
+        }
+
+        /**
+         * @brief Moves the components of an entity into another manager.
+         * @param entity The entity.
+         * @param signature The component types of the entity.
+         * @param destination Manager receiving the components, with every type of
+         *        signature registered (sparse-set storage on both sides).
+         * @param target The entity owning the components in destination.
+         */
+        void transferEntity(Entity entity, const Signature& signature, ComponentManager &destination, Entity target)
+        {
+            forEachSetBit(signature, [&](ComponentTypeID type) {
+                if (GroupData *group = groupOf[type]) {
+                    group->leave(entity);
+                }
+                componentStorages[type]->transferEntity(entity, *destination.componentStorages[type], target);
+                if (GroupData *group = destination.groupOf[type]) {
+                    group->tryJoin(target);
+                }
+            });
+        }
+
+        /**
+         * @brief Enables change tracking on the storage of a component type.
+         * @tparam T Component type.
+         * @throws std::logic_error in archetype storage mode.
+         * @throws std::out_of_range if the component type is not registered.
+         */
+        template <typename T>
+        void enableChangeTracking()
+        {
+            if (storageMode == StorageMode::Archetype) {
+                throw std::logic_error("Change tracking requires sparse-set storage.");
+            }
+            GetComponentStorage<T>()->setChangeTracking(true);
+        }
+
+        /**
+         * @brief Sets the tick stamped on component additions and changes.
+         * @param tick The new current tick.
+         */
+        void setCurrentTick(Tick tick)
+        {
+            currentTick = tick;
+            for (auto const& storage : componentStorages)
+            {
+                if (storage) {
+                    storage->setCurrentTick(tick);
+                }
+            }
+        }
+
+        /**
+         * @brief Checks that every registered storage can be written to a snapshot.
+         * @return Number of registered storages to save (Shared<T> ones are skipped).
+         * @throws std::logic_error in archetype storage mode, or if a registered
+         *         component type is not trivially copyable.
+         */
+        std::uint32_t checkSnapshotable() const
+        {
+            if (storageMode == StorageMode::Archetype) {
+                throw std::logic_error("Snapshots require sparse-set storage.");
+            }
+            std::uint32_t count = 0;
+            for (auto const& storage : componentStorages)
+            {
+                if (!storage || storage->isSnapshotSkipped()) {
+                    continue;
+                }
+                if (!storage->isSnapshotable()) {
+                    throw std::logic_error(std::string("Component type is not trivially copyable: ") + storage->typeName());
+                }
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Writes every registered storage to a snapshot.
+         * @param writer The snapshot writer.
+         * @throws std::logic_error (before writing anything) as checkSnapshotable().
+         */
+        void saveSnapshot(SnapshotWriter &writer) const
+        {
+            writer.write(checkSnapshotable());
+            Signature skipped;
+            for (std::size_t type = 0; type < componentStorages.size(); ++type)
+            {
+                if (componentStorages[type] && componentStorages[type]->isSnapshotSkipped()) {
+                    skipped.set(type);
+                }
+            }
+            writer.write(skipped);
+            for (std::size_t type = 0; type < componentStorages.size(); ++type)
+            {
+                auto const& storage = componentStorages[type];
+                if (storage && !storage->isSnapshotSkipped()) {
+                    writer.write(static_cast<ComponentTypeID>(type));
+                    writer.writeString(storage->typeName());
+                    storage->saveSnapshot(writer);
+                }
+            }
+        }
+
+        /**
+         * @brief Replaces the content of the storages with the one of a snapshot.
+         * @param reader The snapshot reader.
+         * @param entities The entity manager, already loaded from the same snapshot
+         *        (its signatures still use the type IDs of the snapshot).
+         * @return For each component type ID of the snapshot, the matching ID in this
+         *         process (type IDs depend on registration order).
+         * @throws std::runtime_error if a component type of the snapshot is not registered,
+         *         or if the storages do not match the loaded signatures.
+         *
+         * Registered storages absent from the snapshot are emptied, and the bits of the
+         * types the snapshot skipped (Shared<T>) are cleared from the signatures. Every owner of a
+         * loaded storage must be a living entity whose signature has the bit of the
+         * type, and every signature bit must be backed by a loaded storage.
+         */
+        std::array<ComponentTypeID, MAX_COMPONENTS> loadSnapshot(SnapshotReader &reader, EntityManager &entities)
+        {
+            if (storageMode == StorageMode::Archetype) {
+                throw std::logic_error("Snapshots require sparse-set storage.");
+            }
+            std::array<ComponentTypeID, MAX_COMPONENTS> remap{};
+            for (auto const& storage : componentStorages)
+            {
+                if (storage) {
+                    storage->clear();
+                }
+            }
+            Signature loaded;
+            std::uint32_t count = reader.read<std::uint32_t>();
+            Signature skipped = reader.read<Signature>();
+            for (Entity entity : entities.getEntities())
             {
-                auto const& component = pair.second;
-                component->entityDestroyed(entity);
+                Signature signature = entities.getSignature(entity);
+                forEachSetBit(skipped, [&signature](ComponentTypeID type) { signature.reset(type); });
+                entities.setSignature(entity, signature);
             }
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                ComponentTypeID saved = reader.read<ComponentTypeID>();
+                if (saved >= MAX_COMPONENTS || loaded.test(saved) || skipped.test(saved)) {
+                    throw std::runtime_error("Snapshot: corrupted component type ID.");
+                }
+                loaded.set(saved);
+                std::string name = reader.readString();
+                AComponentStorage *target = nullptr;
+                for (std::size_t type = 0; type < componentStorages.size() && !target; ++type)
+                {
+                    if (componentStorages[type] && name == componentStorages[type]->typeName()) {
+                        target = componentStorages[type].get();
+                        remap[saved] = static_cast<ComponentTypeID>(type);
+                    }
+                }
+                if (!target) {
+                    throw std::runtime_error("Snapshot: component type not registered: " + name);
+                }
+                target->loadSnapshot(reader);
+                target->setCurrentTick(currentTick);
+                checkSnapshotOwners(*target, saved, entities);
+            }
+            for (Entity entity : entities.getEntities())
+            {
+                if (!loaded.contains(entities.getSignature(entity))) {
+                    throw std::runtime_error("Snapshot: corrupted signatures.");
+                }
+            }
+            for (auto const& group : groups)
+            {
+                group->rebuild();
+            }
+            return remap;
+        }
+
+        /**
+         * @brief Gets the storage of a component type
+         * @tparam T Component type.
+         * @return Pointer to the storage, or nullptr if the type is not registered
+         *         (always nullptr in archetype storage mode).
+         */
+        template <typename T>
+        ComponentStorage<T>* getComponentStorage()
+        {
+            return static_cast<ComponentStorage<T>*>(componentStorages[ComponentType::id<T>()].get());
+        }
+
+        /**
+         * @brief Checks if a component type is registered.
+         * @tparam T Component type.
+         * @return True if registerComponent<T>() was called.
+         */
+        template <typename T>
+        bool isRegistered() const
+        {
+            return registeredTypes.test(ComponentType::id<T>());
+        }
+
+        /**
+         * @brief Gets the storage backend in use.
+         * @return The storage mode.
+         */
+        StorageMode getStorageMode() const
+        {
+            return storageMode;
+        }
+
+        /**
+         * @brief Gets the archetype storage (only populated in archetype storage mode).
+         * @return Reference to the archetype storage.
+         */
+        ArchetypeStorage& getArchetypeStorage()
+        {
+            return archetypeStorage;
         }
 
     private:
-        std::unordered_map<std::type_index, ComponentTypeID> componentTypes{};
-        std::unordered_map<std::type_index, std::shared_ptr<AComponentStorage>> ComponentStorages{};
-        ComponentTypeID nextComponentType{};
+        StorageMode storageMode{StorageMode::SparseSet};
+        std::pmr::memory_resource *memoryResource{};
+        ArchetypeStorage archetypeStorage{};
+        std::array<std::unique_ptr<AComponentStorage>, MAX_COMPONENTS> componentStorages{};
+        Signature registeredTypes{};
+        Tick currentTick{1};
+        std::vector<std::unique_ptr<GroupData>> groups{};
+        std::array<GroupData*, MAX_COMPONENTS> groupOf{};
+
+        /**
+         * @brief Checks that a loaded storage holds exactly the entities whose signature has its bit.
+         * @param storage The loaded storage.
+         * @param saved Type ID of the storage in the snapshot.
+         * @param entities The loaded entity manager.
+         * @throws std::runtime_error on mismatch.
+         */
+        static void checkSnapshotOwners(const AComponentStorage &storage, ComponentTypeID saved, EntityManager &entities)
+        {
+            for (std::size_t i = 0; i < storage.entityCount(); ++i)
+            {
+                Entity entity = storage.entityAt(i);
+                if (!entities.entityExists(entity) || !entities.getSignature(entity).test(saved)) {
+                    throw std::runtime_error(std::string("Snapshot: corrupted owners of ") + storage.typeName() + ".");
+                }
+            }
+            std::size_t owners = 0;
+            for (Entity entity : entities.getEntities())
+            {
+                owners += entities.getSignature(entity).test(saved);
+            }
+            if (owners != storage.entityCount()) {
+                throw std::runtime_error(std::string("Snapshot: corrupted owners of ") + storage.typeName() + ".");
+            }
+        }
 
         /**
          * @brief Get the Component Storage object
          * @tparam T
-         * @return std::shared_ptr<ComponentStorage<T>>
+         * @return ComponentStorage<T>*
+         * @throws std::out_of_range if the component type is not registered.
          */
         template <typename T>
-        std::shared_ptr<ComponentStorage<T>> GetComponentStorage()
+        ComponentStorage<T>* GetComponentStorage()
         {
-            std::type_index typeName = typeid(T);
-            return std::static_pointer_cast<ComponentStorage<T>>(ComponentStorages[typeName]);
+            ComponentStorage<T>* storage = getComponentStorage<T>();
+            if (!storage) {
+                throw std::out_of_range(std::string("Component type not registered: ") + typeid(T).name());
+            }
+            return storage;
         }
 };
@@ -1,32 +1,153 @@
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
+#include <memory_resource>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 #include "AComponentStorage.hpp"
+#include "EntitySet.hpp"
+#include "Shared.hpp"
+#include "Snapshot.hpp"
+#include "SoA.hpp"
+#include "Tag.hpp"
 #include "Types.hpp"
 
 /**
- * @class ComponentStorage
- * @brief Stores component data for entities using an unordered map.
+ * @class BasicComponentStorage
+ * @brief Stores component data for entities using a sparse set, without any virtual call.
  * @tparam T Component type.
+ *
+ * Components are kept packed in a contiguous array, parallel to the packed entity
+ * array of an EntitySet. The set's sparse array maps an entity back to its packed
+ * slot, so lookups are a plain index with no hashing, and removals swap the last
+ * element into the freed slot to keep the arrays dense.
+ *
+ * Used directly by World, and through ComponentStorage by the ComponentManager.
+ * Every array allocates from the std::pmr::memory_resource given at construction.
+ *
+ * Change tracking is opt-in (setChangeTracking()): when enabled, two tick arrays
+ * parallel to the components record when each component was added and last
+ * changed. Insertions stamp both; getDataMut() and markChanged() stamp the
+ * changed tick. Without tracking the arrays stay empty and cost nothing.
+ * Tracking also logs, for the current tick only, the entities whose component was
+ * added or first changed (changeLog()), so Changed<T> / Added<T> views walk the
+ * touched entries instead of the whole storage. The logs are reset by
+ * setCurrentTick().
+ *
+ * Components declaring a SoALayout are kept as one aligned column per field
+ * (SoAColumns) instead of an array of T; their accessors return SoARef<T> proxies
+ * (Reference) and columns() exposes the columns.
+ *
+ * Tags (empty, trivial types, see isTag) keep no component array at all: the
+ * entity set is the whole storage, and every accessor returns the same instance.
  */
 template <typename T>
-class ComponentStorage : public AComponentStorage {
+class BasicComponentStorage {
+    using Container = std::conditional_t<isSoA<T>, SoAColumns<T>,
+                                         std::conditional_t<isTag<T>, TagColumn<T>, std::pmr::vector<T>>>;
+
 public:
+    /** Type returned by the accessors: T&, or SoARef<T> for SoA components */
+    using Reference = ComponentRef<T>;
+
     /**
-     * @brief Inserts or updates component data for an entity.
+     * @brief Creates an empty storage.
+     * @param resource Memory resource backing the component and entity arrays.
+     */
+    explicit BasicComponentStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : components(resource), dense(resource), addedTicks(resource), changedTicks(resource),
+          addedLog(resource), changedLog(resource), addedLogPositions(resource), changedLogPositions(resource) {}
+
+    /**
+     * @brief Inserts component data for an entity.
      * @param entity The entity.
      * @param component The component data.
+     *
+     * If the entity already owns a component of this type, the existing data is kept.
      */
     void insertData(Entity entity, T component) {
-        componentMap.emplace(entity, component);
+        emplaceData(entity, std::move(component));
+    }
+
+    /**
+     * @brief Constructs component data for an entity in place.
+     * @param entity The entity.
+     * @param args Arguments forwarded to the constructor of T.
+     * @return Reference to the new component, or to the existing one if the entity
+     *         already owns a component of this type (args are then left untouched).
+     */
+    template <typename... Args>
+    Reference emplaceData(Entity entity, Args&&... args) {
+        if (dense.contains(entity)) {
+            return getDataUnchecked(entity);
+        }
+        if constexpr (isSoA<T> || isTag<T>) {
+            components.emplace_back(std::forward<Args>(args)...);
+        } else if constexpr (std::is_constructible_v<T, Args&&...>) {
+            components.emplace_back(std::forward<Args>(args)...);
+        } else {
+            // Aggregates cannot be constructed with parentheses before C++20
+            components.emplace_back(T{std::forward<Args>(args)...});
+        }
+        try {
+            if (tracking) {
+                addedTicks.push_back(currentTick);
+                changedTicks.push_back(currentTick);
+                // A log entry left behind by a failed insertion is rejected by loggedAt()
+                addedLogPositions.push_back(static_cast<std::uint32_t>(addedLog.size()));
+                changedLogPositions.push_back(static_cast<std::uint32_t>(changedLog.size()));
+                addedLog.push_back(entity);
+                changedLog.push_back(entity);
+            }
+            dense.insert(entity);
+        } catch (...) {
+            components.pop_back();
+            if (tracking) {
+                addedTicks.resize(components.size());
+                changedTicks.resize(components.size());
+                addedLogPositions.resize(components.size());
+                changedLogPositions.resize(components.size());
+            }
+            throw;
+        }
+        return components.back();
     }
 
     /**
      * @brief Removes component data for an entity.
      * @param entity The entity.
+     *
+     * The last component is moved into the freed slot (swap-and-pop).
      */
     void removeData(Entity entity) {
-        componentMap.erase(entity);
+        if (!hasData(entity)) {
+            return;
+        }
+        std::size_t index = dense.indexOf(entity);
+        std::size_t last = dense.size() - 1;
+
+        if (index != last) {
+            components[index] = std::move(components[last]);
+        }
+        components.pop_back();
+        if (tracking) {
+            addedTicks[index] = addedTicks[last];
+            addedTicks.pop_back();
+            changedTicks[index] = changedTicks[last];
+            changedTicks.pop_back();
+            addedLogPositions[index] = addedLogPositions[last];
+            addedLogPositions.pop_back();
+            changedLogPositions[index] = changedLogPositions[last];
+            changedLogPositions.pop_back();
+        }
+        dense.erase(entity);
     }
 
     /**
@@ -35,8 +156,189 @@ public:
      * @return Reference to the component data.
      * @throws std::out_of_range if the entity does not exist.
      */
-    T& getData(Entity entity) {
-        return componentMap.at(entity);
+    Reference getData(Entity entity) {
+        if (!hasData(entity)) {
+            throw std::out_of_range("ComponentStorage::getData: entity has no such component.");
+        }
+        return components[dense.indexOf(entity)];
+    }
+
+    /**
+     * @brief Retrieves component data for an entity, marking it as changed.
+     * @param entity The entity.
+     * @return Reference to the component data.
+     * @throws std::out_of_range if the entity does not exist.
+     */
+    Reference getDataMut(Entity entity) {
+        Reference component = getData(entity);
+        if (tracking) {
+            stampChanged(dense.indexOf(entity));
+        }
+        return component;
+    }
+
+    /**
+     * @brief Marks the component of an entity as changed during the current tick.
+     * @param entity The entity (ignored if it has no such component).
+     */
+    void markChanged(Entity entity) {
+        if (tracking && hasData(entity)) {
+            stampChanged(dense.indexOf(entity));
+        }
+    }
+
+    /**
+     * @brief Enables or disables change tracking.
+     * @param enabled True to record added / changed ticks.
+     *
+     * Components already stored when tracking is enabled count as added and changed
+     * during the current tick (without being logged: changeLog() is unavailable until
+     * the next tick).
+     */
+    void setChangeTracking(bool enabled) {
+        tracking = enabled;
+        addedTicks.assign(enabled ? components.size() : 0, currentTick);
+        changedTicks.assign(enabled ? components.size() : 0, currentTick);
+        addedLogPositions.assign(enabled ? components.size() : 0, 0);
+        changedLogPositions.assign(enabled ? components.size() : 0, 0);
+        resetLogs(enabled && components.size() == 0 ? currentTick : 0);
+    }
+
+    /**
+     * @brief Checks whether change tracking is enabled.
+     * @return True if added / changed ticks are recorded.
+     */
+    bool isChangeTracked() const {
+        return tracking;
+    }
+
+    /**
+     * @brief Sets the tick stamped on components added or changed from now on.
+     * @param tick The current tick.
+     *
+     * Starting a new tick empties the change logs.
+     */
+    void setCurrentTick(Tick tick) {
+        if (tick != currentTick) {
+            resetLogs(tick);
+        }
+        currentTick = tick;
+    }
+
+    /**
+     * @brief Gets the entities whose component was added or changed during the current tick.
+     * @param added True for the added log, false for the changed log.
+     * @param since Oldest tick the caller accepts.
+     * @return The log, or nullptr if it does not hold every stamp at or after since
+     *         (since before the current tick, tracking disabled or just enabled, or a
+     *         snapshot loaded during this tick).
+     *
+     * Entries are in stamping order and may be stale (component removed, or re-added
+     * later in the tick): keep entry i only if loggedAt(entity, i, added). The log
+     * grows when components are changed, so index it rather than keeping pointers.
+     */
+    const std::pmr::vector<Entity>* changeLog(bool added, Tick since) const {
+        if (!tracking || logTick != currentTick || since < currentTick) {
+            return nullptr;
+        }
+        return added ? &addedLog : &changedLog;
+    }
+
+    /**
+     * @brief Checks whether an entry of a change log is the live one of its entity.
+     * @param entity Entity of the entry.
+     * @param position Index of the entry in changeLog(added, ...).
+     * @param added True for the added log, false for the changed log.
+     * @return True if the entity still owns the component, stamped this tick at that entry.
+     */
+    bool loggedAt(Entity entity, std::size_t position, bool added) const {
+        if (!hasData(entity)) {
+            return false;
+        }
+        std::size_t index = dense.indexOf(entity);
+        if (added) {
+            return addedTicks[index] == currentTick && addedLogPositions[index] == position;
+        }
+        return changedTicks[index] == currentTick && changedLogPositions[index] == position;
+    }
+
+    /**
+     * @brief Gets the tick stamped on components added or changed from now on.
+     * @return The current tick.
+     */
+    Tick getCurrentTick() const {
+        return currentTick;
+    }
+
+    /**
+     * @brief Gets the tick at which the component of an entity was added.
+     * @param entity The entity, which must own a component of this type (tracking enabled).
+     * @return The added tick.
+     */
+    Tick addedTick(Entity entity) const {
+        return addedTicks[dense.indexOf(entity)];
+    }
+
+    /**
+     * @brief Gets the tick at which the component of an entity last changed.
+     * @param entity The entity, which must own a component of this type (tracking enabled).
+     * @return The changed tick.
+     */
+    Tick changedTick(Entity entity) const {
+        return changedTicks[dense.indexOf(entity)];
+    }
+
+    /**
+     * @brief Retrieves component data for an entity without checking ownership.
+     * @param entity The entity, which must own a component of this type.
+     * @return Reference to the component data.
+     */
+    Reference getDataUnchecked(Entity entity) {
+        return components[dense.indexOf(entity)];
+    }
+
+    /**
+     * @brief Retrieves the component stored in a packed slot.
+     * @param index The packed index, below size().
+     * @return Reference to the component of entities()[index].
+     */
+    Reference at(std::size_t index) {
+        return components[index];
+    }
+
+    /**
+     * @brief Gets the packed slot of the component of an entity.
+     * @param entity The entity, which must own a component of this type.
+     * @return Index into entities() and the component array.
+     */
+    std::size_t indexOf(Entity entity) const {
+        return dense.indexOf(entity);
+    }
+
+    /**
+     * @brief Exchanges two packed slots, with their entities and ticks.
+     * @param a Packed index, below size().
+     * @param b Packed index, below size().
+     *
+     * Used by owning groups to keep their members at the front of the arrays.
+     */
+    void swapEntries(std::size_t a, std::size_t b) {
+        if (a == b) {
+            return;
+        }
+        if constexpr (isSoA<T>) {
+            components.swapRows(a, b);
+        } else if constexpr (!isTag<T>) {
+            using std::swap;
+            swap(components[a], components[b]);
+        }
+        if (tracking) {
+            std::swap(addedTicks[a], addedTicks[b]);
+            std::swap(changedTicks[a], changedTicks[b]);
+            std::swap(addedLogPositions[a], addedLogPositions[b]);
+            std::swap(changedLogPositions[a], changedLogPositions[b]);
+        }
+        dense.swapPositions(a, b);
     }
 
     /**
@@ -45,17 +347,378 @@ public:
      * @return True if the entity has a component, otherwise false.
      */
     bool hasData(Entity entity) const {
-        return componentMap.find(entity) != componentMap.end();
+        return dense.contains(entity);
+    }
+
+    /**
+     * @brief Gets the number of stored components.
+     * @return Number of entities owning this component.
+     */
+    std::size_t size() const {
+        return dense.size();
+    }
+
+    /**
+     * @brief Reserves room for a number of components.
+     * @param capacity Number of components to reserve.
+     */
+    void reserve(std::size_t capacity) {
+        dense.reserve(capacity);
+        components.reserve(capacity);
+        if (tracking) {
+            addedTicks.reserve(capacity);
+            changedTicks.reserve(capacity);
+            addedLogPositions.reserve(capacity);
+            changedLogPositions.reserve(capacity);
+        }
+    }
+
+    /**
+     * @brief Gets the packed component array (not available for SoA components and tags).
+     * @return Pointer to the first component, contiguous over size() elements.
+     */
+    T* data() {
+        static_assert(!isSoA<T>, "SoA components have no packed array, use columns()");
+        static_assert(!isTag<T>, "Tags have no packed array, use entities()");
+        return components.data();
+    }
+
+    /**
+     * @brief Gets the field columns of a SoA component, parallel to entities().
+     * @return One span per field, valid until the next structural change.
+     */
+    SoASpan<T> columns() {
+        static_assert(isSoA<T>, "columns() is only available for components declaring a SoALayout");
+        return SoASpan<T>(Span<const Entity>(dense.data(), dense.size()), components.columnData());
+    }
+
+    /**
+     * @brief Gets the packed entity array, parallel to data().
+     * @return Pointer to the first entity, contiguous over size() elements.
+     */
+    const Entity* entities() const {
+        return dense.data();
+    }
+
+    /**
+     * @brief Removes every component.
+     */
+    void clear() {
+        components.clear();
+        dense.clear();
+        addedTicks.clear();
+        changedTicks.clear();
+        addedLogPositions.clear();
+        changedLogPositions.clear();
+        resetLogs(currentTick);
+    }
+
+    /**
+     * @brief Writes the packed arrays to a snapshot, one block per array.
+     * @param writer The snapshot writer.
+     */
+    void saveSnapshot(SnapshotWriter& writer) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshots only hold trivially copyable components");
+        writer.write(static_cast<std::uint32_t>(components.size()));
+        writer.write(static_cast<std::uint8_t>(tracking));
+        writer.writeArray(dense.data(), dense.size());
+        if constexpr (isSoA<T> || isTag<T>) {
+            components.saveSnapshot(writer);
+        } else {
+            writer.writeArray(components.data(), components.size());
+        }
+        writer.writeArray(addedTicks.data(), addedTicks.size());
+        writer.writeArray(changedTicks.data(), changedTicks.size());
+    }
+
+    /**
+     * @brief Replaces the content with the packed arrays of a snapshot.
+     * @param reader The snapshot reader.
+     * @throws std::runtime_error if the snapshot is truncated, holds more owners than
+     *         entity indices exist, or lists an owner twice (the storage is left empty).
+     *
+     * Owners are not checked against the entities: ComponentManager::loadSnapshot()
+     * does that once every storage is loaded.
+     */
+    void loadSnapshot(SnapshotReader& reader) {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                      "Snapshots only hold trivially copyable, default-constructible components");
+        std::size_t count = reader.read<std::uint32_t>();
+        tracking = reader.read<std::uint8_t>() != 0;
+        clear();
+        if (count > ENTITY_INDEX_MASK) {
+            throw std::runtime_error("Snapshot: corrupted component count.");
+        }
+        reader.requireAvailable(count * sizeof(Entity));
+        std::vector<Entity> owners(count);
+        reader.readArray(owners.data(), count);
+        dense.reserve(count);
+        for (Entity entity : owners) {
+            if (!dense.insert(entity)) {
+                dense.clear();
+                throw std::runtime_error("Snapshot: corrupted component owners.");
+            }
+        }
+        if constexpr (isSoA<T> || isTag<T>) {
+            components.loadSnapshot(reader, count);
+        } else {
+            components.resize(count);
+            reader.readArray(components.data(), count);
+        }
+        if (tracking) {
+            addedTicks.resize(count);
+            changedTicks.resize(count);
+            reader.readArray(addedTicks.data(), count);
+            reader.readArray(changedTicks.data(), count);
+            addedLogPositions.assign(count, 0);
+            changedLogPositions.assign(count, 0);
+            // Loaded stamps of the current tick are not logged
+            resetLogs(0);
+        }
+    }
+
+private:
+    /** Packed component data (one column per field for SoA components, a count for tags) */
+    Container components;
+
+    /** Owning entity of each packed component */
+    EntitySet dense;
+
+    /** Tick at which each packed component was added (empty without tracking) */
+    std::pmr::vector<Tick> addedTicks;
+
+    /** Tick at which each packed component last changed (empty without tracking) */
+    std::pmr::vector<Tick> changedTicks;
+
+    /** Entities added during logTick, in stamping order (empty without tracking) */
+    std::pmr::vector<Entity> addedLog;
+
+    /** Entities first changed during logTick, in stamping order (empty without tracking) */
+    std::pmr::vector<Entity> changedLog;
+
+    /** Entry of each packed component in addedLog, meaningful while its added tick is currentTick */
+    std::pmr::vector<std::uint32_t> addedLogPositions;
+
+    /** Entry of each packed component in changedLog, meaningful while its changed tick is currentTick */
+    std::pmr::vector<std::uint32_t> changedLogPositions;
+
+    /**
+     * @struct LogMutex
+     * @brief Serializes changed-log appends made under the shared coordinator lock; copies as a fresh mutex
+     */
+    struct LogMutex {
+        std::mutex mutex;
+
+        LogMutex() = default;
+        LogMutex(const LogMutex&) {}
+        LogMutex& operator=(const LogMutex&) { return *this; }
+    };
+
+    LogMutex logMutex;
+
+    bool tracking = false;
+    Tick currentTick = 1;
+
+    /** Tick whose stamps are all logged (0 while the logs are incomplete) */
+    Tick logTick = 1;
+
+    /**
+     * @brief Stamps a packed component as changed, logging it on its first change of the tick.
+     * @param index The packed index.
+     */
+    void stampChanged(std::size_t index) {
+        if (changedTicks[index] == currentTick) {
+            return;
+        }
+        changedTicks[index] = currentTick;
+        std::lock_guard<std::mutex> lock(logMutex.mutex);
+        changedLogPositions[index] = static_cast<std::uint32_t>(changedLog.size());
+        changedLog.push_back(dense[index]);
     }
 
+    /**
+     * @brief Empties the change logs.
+     * @param tick Tick the logs are complete for from now on (0 for none).
+     */
+    void resetLogs(Tick tick) {
+        addedLog.clear();
+        changedLog.clear();
+        logTick = tick;
+    }
+};
+
+/**
+ * @class ComponentStorage
+ * @brief BasicComponentStorage usable through the type-erased AComponentStorage interface.
+ * @tparam T Component type.
+ */
+template <typename T>
+class ComponentStorage : public BasicComponentStorage<T>, public AComponentStorage {
+public:
+    using BasicComponentStorage<T>::BasicComponentStorage;
+
     /**
      * @brief Called when an entity is destroyed.
      * @param entity The destroyed entity.
      */
     void entityDestroyed(Entity entity) override {
-        componentMap.erase(entity);
+        this->removeData(entity);
     }
 
-private:
-    std::unordered_map<Entity, T> componentMap;
+    /**
+     * @brief Sets the tick stamped on components added or changed from now on.
+     * @param tick The current tick.
+     */
+    void setCurrentTick(Tick tick) override {
+        BasicComponentStorage<T>::setCurrentTick(tick);
+    }
+
+    /**
+     * @brief Gets the name identifying the component type in snapshots.
+     * @return The implementation-defined type name.
+     */
+    const char* typeName() const override {
+        return typeid(T).name();
+    }
+
+    /**
+     * @brief Checks whether the component type can be stored in a snapshot.
+     * @return True for trivially copyable, default-constructible types.
+     */
+    bool isSnapshotable() const override {
+        return std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>;
+    }
+
+    /**
+     * @brief Checks whether snapshots leave the component type out.
+     * @return True for Shared<U> handles.
+     */
+    bool isSnapshotSkipped() const override {
+        return isShared<T>;
+    }
+
+    /**
+     * @brief Writes the component size and packed arrays to a snapshot.
+     * @param writer The snapshot writer.
+     * @throws std::logic_error if the component type is not snapshotable.
+     */
+    void saveSnapshot(SnapshotWriter& writer) const override {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+            writer.write(static_cast<std::uint32_t>(sizeof(T)));
+            BasicComponentStorage<T>::saveSnapshot(writer);
+        } else {
+            (void)writer;
+            throw std::logic_error(std::string("Component type is not trivially copyable: ") + typeid(T).name());
+        }
+    }
+
+    /**
+     * @brief Replaces the content with the one written by saveSnapshot().
+     * @param reader The snapshot reader.
+     * @throws std::logic_error if the component type is not snapshotable.
+     * @throws std::runtime_error if the stored component size differs.
+     */
+    void loadSnapshot(SnapshotReader& reader) override {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+            reader.expect(static_cast<std::uint32_t>(sizeof(T)), "component size");
+            BasicComponentStorage<T>::loadSnapshot(reader);
+        } else {
+            (void)reader;
+            throw std::logic_error(std::string("Component type is not trivially copyable: ") + typeid(T).name());
+        }
+    }
+
+    /**
+     * @brief Removes every component.
+     */
+    void clear() override {
+        BasicComponentStorage<T>::clear();
+    }
+
+    /**
+     * @brief Checks if an entity has a component.
+     * @param entity The entity.
+     * @return True if the entity has a component of this type.
+     */
+    bool hasEntity(Entity entity) const override {
+        return this->hasData(entity);
+    }
+
+    /**
+     * @brief Gets the packed slot of the component of an entity.
+     * @param entity The entity, which must own a component of this type.
+     * @return Index into the packed arrays.
+     */
+    std::size_t indexOfEntity(Entity entity) const override {
+        return this->indexOf(entity);
+    }
+
+    /**
+     * @brief Exchanges two packed slots, with their entities and ticks.
+     * @param a Packed index.
+     * @param b Packed index.
+     */
+    void swapEntries(std::size_t a, std::size_t b) override {
+        BasicComponentStorage<T>::swapEntries(a, b);
+    }
+
+    /**
+     * @brief Gets the number of stored components.
+     * @return Number of entities owning this component.
+     */
+    std::size_t entityCount() const override {
+        return this->size();
+    }
+
+    /**
+     * @brief Gets the entity owning a packed slot.
+     * @param index Packed index, below entityCount().
+     * @return The entity.
+     */
+    Entity entityAt(std::size_t index) const override {
+        return this->entities()[index];
+    }
+
+    /**
+     * @brief Creates an empty storage of the same component type.
+     * @param resource Memory resource backing the new storage.
+     * @return The new storage, with the same change tracking setting.
+     */
+    std::unique_ptr<AComponentStorage> cloneEmpty(std::pmr::memory_resource* resource) const override {
+        auto storage = std::make_unique<ComponentStorage<T>>(resource);
+        storage->setChangeTracking(this->isChangeTracked());
+        return storage;
+    }
+
+    /**
+     * @brief Replaces the content with a copy of another storage of the same type.
+     * @param source The storage to copy, a ComponentStorage<T>.
+     * @throws std::logic_error if the component type is not copyable.
+     *
+     * The arrays keep their memory resource and reuse their capacity.
+     */
+    void copyFrom(const AComponentStorage& source) override {
+        if constexpr (std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>) {
+            BasicComponentStorage<T>::operator=(static_cast<const ComponentStorage<T>&>(source));
+        } else {
+            (void)source;
+            throw std::logic_error(std::string("Component type is not copyable: ") + typeid(T).name());
+        }
+    }
+
+    /**
+     * @brief Moves the component of an entity into another storage of the same type.
+     * @param entity The entity, which must own a component of this type.
+     * @param destination The storage receiving the component, a ComponentStorage<T>.
+     * @param target The entity owning the component in destination.
+     */
+    void transferEntity(Entity entity, AComponentStorage& destination, Entity target) override {
+        auto& other = static_cast<ComponentStorage<T>&>(destination);
+        if constexpr (isSoA<T>) {
+            other.emplaceData(target, this->getDataUnchecked(entity).load());
+        } else {
+            other.emplaceData(target, std::move(this->getDataUnchecked(entity)));
+        }
+        this->removeData(entity);
+    }
 };
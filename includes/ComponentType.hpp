@@ -0,0 +1,55 @@
+/**
+ * @file ComponentType.hpp
+ * @brief Process-wide, per-type component type IDs
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Types.hpp"
+
+/**
+ * @class ComponentType
+ * @brief Hands out one ComponentTypeID per component type, without any lookup
+ *
+ * Each type gets its ID the first time ComponentType::id<T>() is called, from a
+ * global counter; the ID is then cached in a function-local static, so getting it
+ * again is a plain load. IDs are shared by every ComponentManager of the process.
+ */
+class ComponentType {
+public:
+    /**
+     * @brief Gets the ID of a component type
+     * @tparam T Component type; references and const/volatile are ignored, so
+     *           id<const T &>() is id<T>()
+     * @return ID of T, lower than MAX_COMPONENTS
+     * @throws std::length_error if more than MAX_COMPONENTS types are used
+     */
+    template <typename T>
+    static ComponentTypeID id() {
+        using Component = std::remove_cv_t<std::remove_reference_t<T>>;
+        if constexpr (!std::is_same_v<T, Component>) {
+            return id<Component>();
+        } else {
+            static const ComponentTypeID value = next();
+            return value;
+        }
+    }
+
+private:
+    static std::atomic<std::size_t> &counter() {
+        static std::atomic<std::size_t> value{0};
+        return value;
+    }
+
+    static ComponentTypeID next() {
+        std::size_t id = counter().fetch_add(1, std::memory_order_acq_rel);
+        if (id >= MAX_COMPONENTS) {
+            throw std::length_error("Too many component types (maximum " + std::to_string(MAX_COMPONENTS) + ").");
+        }
+        return static_cast<ComponentTypeID>(id);
+    }
+};
@@ -8,33 +8,83 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <exception>
 #include <functional>
 #include <future>
 #include <iostream>
+#include <istream>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
+#include <ostream>
 #include <shared_mutex>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // Project-specific includes for core ECS components
+#include "CommandBuffer.hpp"
 #include "ComponentManager.hpp"
 #include "EntityManager.hpp"
+#include "Group.hpp"
+#include "Observer.hpp"
+#include "Profiler.hpp"
+#include "Shared.hpp"
+#include "Snapshot.hpp"
+#include "Span.hpp"
 #include "SystemManager.hpp"
 #include "Types.hpp"
+#include "View.hpp"
+
+/**
+ * @struct CoordinatorConfig
+ * @brief Options used to initialize a Coordinator
+ */
+struct CoordinatorConfig {
+    /** Component storage backend (sparse sets by default) */
+    StorageMode storageMode = StorageMode::SparseSet;
+
+    /** Maximum number of living entities */
+    Entity maxEntities = MAX_ENTITIES;
+
+    /**
+     * Memory resource backing entity pages, sparse-set storages and system entity
+     * sets (the default resource if null), e.g. WorldArena::resource(). Archetype
+     * chunks and archetype bookkeeping always use the global allocator. The resource
+     * must be thread-safe: change-tracked storages also allocate under the shared lock
+     */
+    std::pmr::memory_resource *memoryResource = nullptr;
+};
 
 /**
  * @class Coordinator
  * @brief Coordinates entities, components, and systems.
  *
- * This version defers modifications (destroyEntity, addComponent, removeComponent)
- * via a thread-safe command queue. Modifications are enqueued (async) and applied
- * when flushCommands() is called (typically once per frame).
+ * Structural modifications (destroyEntity, addComponent, removeComponent) can be
+ * deferred via a thread-safe command buffer. When async modifications are enabled
+ * with setAsyncModifications(true), these calls are recorded without taking the ECS
+ * mutex and applied in a single batch when flushCommands() is called (typically once
+ * per frame). Async modifications are disabled by default, so the calls apply immediately.
  *
- * For cases where you require immediate (synchronous) execution you have two options:
+ * For cases where you require immediate (synchronous) execution while async
+ * modifications are enabled you have two options:
  *   - Call the alternative sync methods (e.g. addComponentSync).
  *   - Turn off async modifications globally by calling setAsyncModifications(false).
  *
+ * Read-only calls (getComponent, hasComponent, entityExists, view, ...) take the
+ * ECS mutex in shared mode, so reader threads never serialize each other; only
+ * structural changes take it exclusively.
+ *
+ * For lock-free reads, wrap the parallel part of a frame in beginParallelPhase() /
+ * endParallelPhase(). During the phase, destroyEntity/addComponent/removeComponent
+ * are always deferred, reads take no lock at all, and the operations that would
+ * change the structure immediately (createEntity, the *Sync methods, flushCommands)
+ * throw std::logic_error. endParallelPhase() is the sync point that applies the
+ * recorded commands.
+ *
  * Note on getComponent: This method returns a reference for direct read/edit access.
  * If you plan to modify a component from multiple threads, you should either perform
  * the modification only after flushCommands() or provide a dedicated update method
@@ -44,13 +94,65 @@ class Coordinator {
 public:
     /**
      * @brief Initializes the coordinator
+     * @param config Initialization options
      *
-     * Creates instances of the component, entity, and system managers.
+     * Creates instances of the component, entity, and system managers (after a
+     * shutdown() of the previous ones, if any).
+     * With StorageMode::Archetype, components are grouped by archetype in chunks and
+     * every System::archetypes list is kept up to date as archetypes are created.
      */
-    void init() {
-        componentManager = std::make_unique<ComponentManager>();
-        entityManager = std::make_unique<EntityManager>();
-        systemManager = std::make_unique<SystemManager>();
+    void init(CoordinatorConfig config = {}) {
+        shutdown();
+        std::pmr::memory_resource *resource =
+            config.memoryResource ? config.memoryResource : std::pmr::get_default_resource();
+        componentManager = std::make_unique<ComponentManager>(config.storageMode, resource);
+        entityManager = std::make_unique<EntityManager>(config.maxEntities, resource);
+        systemManager = std::make_unique<SystemManager>(resource);
+        m_currentTick = 1;
+
+        if (config.storageMode == StorageMode::Archetype) {
+            componentManager->getArchetypeStorage().setArchetypeCreatedCallback(
+                [this](Archetype &archetype) { systemManager->archetypeCreated(archetype); });
+        }
+    }
+
+    /**
+     * @brief Initializes the coordinator with the component types of another one
+     * @param prototype Coordinator whose registered component types are shared
+     * @param config Initialization options; the storage mode must be the prototype's
+     *
+     * Same as init() followed by registerComponent() for every type of the prototype
+     * (keeping its change tracking settings), without the per-type registration work
+     * and output: meant for spinning up many worlds of one schema, e.g. one per match.
+     * @throws std::invalid_argument if prototype is this coordinator
+     * @throws std::logic_error if the storage modes differ
+     */
+    void initFrom(Coordinator &prototype, CoordinatorConfig config = {}) {
+        if (&prototype == this) {
+            throw std::invalid_argument("Coordinator::initFrom: a coordinator cannot be its own prototype.");
+        }
+        init(config);
+        auto lock = prototype.readLock();
+        componentManager->registerComponentsOf(*prototype.componentManager);
+    }
+
+    /**
+     * @brief Destroys every entity, component, system and pending command
+     *
+     * Everything allocated from CoordinatorConfig::memoryResource is returned to it,
+     * so the resource (e.g. a WorldArena) can be released afterwards. System pointers
+     * obtained from registerSystem() must not outlive this call in that case. The
+     * coordinator must be init() again before further use.
+     */
+    void shutdown() {
+        auto lock = writeLock();
+        m_commands.drain();
+        m_observers.clear();
+        m_singletons.clear();
+        m_parallelPhase.store(false, std::memory_order_release);
+        systemManager.reset();
+        componentManager.reset();
+        entityManager.reset();
     }
 
     /**
@@ -58,19 +160,21 @@ public:
      * @return Unique identifier for the created entity
      *
      * Thread-safe creation of a new entity.
+     * @throws std::logic_error during a parallel phase
      */
     Entity createEntity() {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        requireSyncPoint("createEntity");
+        auto lock = writeLock();
         return entityManager->createEntity();
     }
 
     /**
      * @brief Checks if an entity exists
      * @param entity Entity ID to check
-     * @return True if the entity exists, false otherwise
+     * @return True if the handle refers to a living entity, false for stale handles
      */
     bool entityExists(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = readLock();
         return entityManager->entityExists(entity);
     }
 
@@ -78,27 +182,76 @@ public:
      * @brief Destroys an entity and removes all its components
      * @param entity Entity ID to destroy
      *
-     * Destroys the entity in a synchronized manner across all managers.
+     * Deferred until flushCommands() when async modifications are enabled or during
+     * a parallel phase, otherwise destroys the entity in a synchronized manner across all managers.
      */
     void destroyEntity(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
-        entityManager->destroyEntity(entity);
-        componentManager->entityDestroyed(entity);
-        systemManager->entityDestroyed(entity);
+        if (deferStructuralChanges()) {
+            m_commands.push(CommandBuffer::CommandType::DestroyEntity, entity, 0,
+                            [this, entity]() { destroyEntityImpl(entity); });
+            return;
+        }
+        destroyEntitySync(entity);
     }
 
     /**
      * @brief Synchronously destroys an entity
      * @param entity Entity ID to destroy
      *
-     * Alternative synchronous version of destroyEntity.
-     * @note Currently identical to destroyEntity as both are synchronous
+     * Always applied immediately, regardless of the async modifications setting.
+     * @throws std::logic_error during a parallel phase
      */
     void destroyEntitySync(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
-        entityManager->destroyEntity(entity);
-        componentManager->entityDestroyed(entity);
-        systemManager->entityDestroyed(entity);
+        requireSyncPoint("destroyEntitySync");
+        structuralChange([&]() { destroyEntityImpl(entity); });
+    }
+
+    /**
+     * @brief Creates several entities at once
+     * @param count Number of entities to create
+     * @param out Receives the count new entity handles
+     *
+     * Takes the ECS mutex once for the whole batch.
+     * @throws std::runtime_error (before creating any) if the capacity would be exceeded
+     * @throws std::logic_error during a parallel phase
+     */
+    void createEntities(std::size_t count, Entity *out) {
+        requireSyncPoint("createEntities");
+        auto lock = writeLock();
+        entityManager->createEntities(count, out);
+    }
+
+    /**
+     * @brief Creates several entities at once
+     * @param count Number of entities to create
+     * @return The new entity handles
+     */
+    std::vector<Entity> createEntities(std::size_t count) {
+        std::vector<Entity> entities(count);
+        createEntities(count, entities.data());
+        return entities;
+    }
+
+    /**
+     * @brief Destroys several entities and all their components
+     * @param entities Entities to destroy (stale handles are ignored)
+     *
+     * Applied under a single acquisition of the ECS mutex, or deferred like
+     * destroyEntity().
+     */
+    void destroyEntities(Span<const Entity> entities) {
+        if (deferStructuralChanges()) {
+            for (Entity entity : entities) {
+                m_commands.push(CommandBuffer::CommandType::DestroyEntity, entity, 0,
+                                [this, entity]() { destroyEntityImpl(entity); });
+            }
+            return;
+        }
+        structuralChange([&]() {
+            for (Entity entity : entities) {
+                destroyEntityImpl(entity);
+            }
+        });
     }
 
     /**
@@ -131,34 +284,371 @@ public:
     }
 
     /**
-     * @brief Adds a component to an entity
+     * @brief Declares the components a system reads and writes
+     * @tparam T System type
+     * @tparam Rs Component types only read by the system
+     * @tparam Ws Component types written by the system
+     *
+     * Example: `setSystemAccess<PhysicsSystem>(Reads<Velocity>{}, Writes<Position>{})`.
+     * runFrame() runs systems whose accesses do not conflict concurrently.
+     */
+    template <typename T, typename... Rs, typename... Ws>
+    void setSystemAccess(Reads<Rs...>, Writes<Ws...>) {
+        auto lock = writeLock();
+        Signature reads;
+        Signature writes;
+        (reads.set(componentManager->getComponentTypeID<Rs>()), ...);
+        (writes.set(componentManager->getComponentTypeID<Ws>()), ...);
+        systemManager->getSystem<T>()->setAccess(reads, writes);
+    }
+
+    /**
+     * @brief Sets the frame phase a system runs in
+     * @tparam T System type
+     * @param phase Phase number (see SystemPhase); lower phases run first
+     */
+    template <typename T>
+    void setSystemPhase(std::uint32_t phase) {
+        auto lock = writeLock();
+        systemManager->getSystem<T>()->setPhase(phase);
+    }
+
+    /**
+     * @brief Runs one frame of every due system on the built-in thread pool
+     * @param deltaTime Time elapsed since the previous frame (in seconds)
+     *
+     * See SystemManager::runFrame(). Systems access the coordinator as usual from
+     * the worker threads; the ECS mutex is not held while they run. Each phase is
+     * followed by flushCommands(), so structural changes deferred by a phase are
+     * visible to the next one. Inside a parallel phase the commands are left for
+     * endParallelPhase() instead.
+     */
+    void runFrame(float deltaTime) {
+        systemManager->runFrame(deltaTime, [this](std::uint32_t) {
+            if (!isParallelPhase()) {
+                flushCommands();
+            }
+        });
+    }
+
+    /**
+     * @brief Calls a function for every entity of a system, spread across the thread pool
+     * @param system System whose entities are processed
+     * @param chunkSize Number of entities per task (0 picks one range per worker)
+     * @param fn Callable taking (Entity), called concurrently from several threads
+     *
+     * Typically called from a system's update(); returns once every entity was processed.
+     * See SystemManager::parallelForEach().
+     */
+    template <typename Fn>
+    void parallelForEach(System &system, std::size_t chunkSize, Fn &&fn) {
+        systemManager->parallelForEach(system, chunkSize, std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Gets the profiling counters of every system, in registration order
+     * @return Wall time, invocation and entity counts and ECS mutex wait time of each
+     *         system (empty unless compiled with ECS_ENABLE_PROFILING)
+     *
+     * Runs through runFrame() and System::executeWhenPossible() are recorded. Read the
+     * stats between frames. Profiler::global() gives the process-wide mutex wait time
+     * and the Chrome trace (setTracing(), writeChromeTrace()).
+     */
+    std::vector<SystemStats> getSystemStats() {
+        return systemManager->getSystemStats();
+    }
+
+    /**
+     * @brief Resets the profiling counters of every system
+     */
+    void resetSystemStats() {
+        systemManager->resetSystemStats();
+    }
+
+    /**
+     * @brief Sets the number of worker threads used by runFrame()
+     * @param threadCount Number of workers (at least one)
+     */
+    void setThreadCount(std::size_t threadCount) {
+        systemManager->setThreadCount(threadCount);
+    }
+
+    /**
+     * @brief Adds a copy of a component to an entity
      * @tparam T Component type to add
      * @param entity Entity to add the component to
-     * @param component Component instance to add
+     * @param component Component instance to copy
+     *
+     * Deferred until flushCommands() when async modifications are enabled or during
+     * a parallel phase. If the entity already owns a T, the existing data is kept
+     * (see replaceComponent() to overwrite it).
      */
     template <typename T>
-    void addComponent(Entity entity, T component) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
-        componentManager->addComponent<T>(entity, component);
-        auto signature = entityManager->getSignature(entity);
-        signature.set(componentManager->getComponentTypeID<T>(), true);
-        entityManager->setSignature(entity, signature);
-        systemManager->entitySignatureChanged(entity, signature);
+    void addComponent(Entity entity, const T &component) {
+        if (deferStructuralChanges()) {
+            addComponent<T>(entity, T(component));
+            return;
+        }
+        addComponentSync<T>(entity, component);
+    }
+
+    /**
+     * @brief Moves a component into an entity
+     * @tparam T Component type to add
+     * @param entity Entity to add the component to
+     * @param component Component instance to move from
+     *
+     * Deferred until flushCommands() when async modifications are enabled or during
+     * a parallel phase. If the entity already owns a T, the existing data is kept
+     * (see replaceComponent() to overwrite it).
+     */
+    template <typename T, typename = std::enable_if_t<!std::is_reference_v<T>>>
+    void addComponent(Entity entity, T &&component) {
+        if (deferStructuralChanges()) {
+            m_commands.push(CommandBuffer::CommandType::AddComponent, entity,
+                            componentManager->getComponentTypeID<T>(),
+                            [this, entity, component = std::move(component)]() mutable {
+                                addComponentImpl<T>(entity, std::move(component));
+                            });
+            return;
+        }
+        addComponentSync<T>(entity, std::move(component));
+    }
+
+    /**
+     * @brief Synchronously adds a copy of a component to an entity
+     * @tparam T Component type to add
+     * @param entity Entity to add the component to
+     * @param component Component instance to copy
+     *
+     * Always applied immediately, regardless of the async modifications setting.
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T>
+    void addComponentSync(Entity entity, const T &component) {
+        requireSyncPoint("addComponentSync");
+        structuralChange([&]() { addComponentImpl<T>(entity, component); });
+    }
+
+    /**
+     * @brief Synchronously moves a component into an entity
+     * @tparam T Component type to add
+     * @param entity Entity to add the component to
+     * @param component Component instance to move from
+     *
+     * Always applied immediately, regardless of the async modifications setting.
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T, typename = std::enable_if_t<!std::is_reference_v<T>>>
+    void addComponentSync(Entity entity, T &&component) {
+        requireSyncPoint("addComponentSync");
+        structuralChange([&]() { addComponentImpl<T>(entity, std::move(component)); });
+    }
+
+    /**
+     * @brief Constructs a component of an entity in place
+     * @tparam T Component type to add
+     * @param entity Entity to add the component to
+     * @param args Arguments forwarded to the constructor of T (brace-initialization for aggregates)
+     * @return Reference to the new component, or to the existing one if the entity already owns a T
+     *
+     * Always applied immediately (like addComponentSync()), so the component is built
+     * directly in its storage without any intermediate copy or move. The reference is
+     * looked up again once the onAdd() observers have run, since they may have moved
+     * the component (by adding to the same storage) or removed it.
+     * @throws std::out_of_range if the entity does not exist, or if an observer removed
+     *         the component or destroyed the entity
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T, typename... Args>
+    ComponentRef<T> emplaceComponent(Entity entity, Args &&...args) {
+        requireSyncPoint("emplaceComponent");
+        bool added = structuralChange([&]() { return static_cast<bool>(addComponentImpl<T>(entity, std::forward<Args>(args)...)); });
+        if (!added) {
+            throw std::out_of_range("Coordinator::emplaceComponent: entity does not exist.");
+        }
+        ComponentPtr<T> component = tryGetComponent<T>(entity);
+        if (!component) {
+            throw std::out_of_range("Coordinator::emplaceComponent: component removed by an observer.");
+        }
+        return *component;
+    }
+
+    /**
+     * @brief Overwrites the component of an entity in place
+     * @tparam T Component type
+     * @param entity Entity owning the component
+     * @param component New value, copied or moved into the existing component
+     * @return Reference to the updated component
+     * @throws std::out_of_range if the entity has no such component
+     *
+     * Not a structural change: nothing is deferred and the mutex is only taken shared.
+     * The component is marked as changed when its storage tracks changes.
+     */
+    template <typename T, typename U>
+    ComponentRef<T> replaceComponent(Entity entity, U &&component) {
+        auto lock = readLock();
+        ComponentRef<T> current = componentManager->getComponentMut<T>(entity);
+        current = std::forward<U>(component);
+        return current;
+    }
+
+    /**
+     * @brief Updates the component of an entity in place through a callable
+     * @tparam T Component type
+     * @param entity Entity owning the component
+     * @param fn Callable taking (T &), or (SoARef<T>) for SoA components
+     * @return Reference to the updated component
+     * @throws std::out_of_range if the entity has no such component
+     *
+     * Not a structural change: nothing is deferred and the mutex is only taken shared.
+     * The component is marked as changed when its storage tracks changes.
+     */
+    template <typename T, typename Fn>
+    ComponentRef<T> patchComponent(Entity entity, Fn &&fn) {
+        auto lock = readLock();
+        ComponentRef<T> current = componentManager->getComponentMut<T>(entity);
+        std::forward<Fn>(fn)(current);
+        return current;
+    }
+
+    /**
+     * @brief Adds a component to each entity of a batch
+     * @tparam T Component type to add
+     * @param entities Entities to add the component to
+     * @param components Component of each entity, parallel to entities
+     * @throws std::invalid_argument if the two spans have different sizes
+     *
+     * The storage is grown once, the ECS mutex is taken once and system membership
+     * is updated in one pass. Deferred as a single command when async modifications
+     * are enabled or during a parallel phase.
+     */
+    template <typename T>
+    void addComponents(Span<const Entity> entities, Span<const T> components) {
+        if (entities.size() != components.size()) {
+            throw std::invalid_argument("Coordinator::addComponents: entities and components sizes differ.");
+        }
+        if (deferStructuralChanges()) {
+            m_commands.push(CommandBuffer::CommandType::AddComponent, NULL_ENTITY,
+                            componentManager->getComponentTypeID<T>(),
+                            [this, batch = std::vector<Entity>(entities.begin(), entities.end()),
+                             data = std::vector<T>(components.begin(), components.end())]() {
+                                addComponentsImpl<T>(batch, data);
+                            });
+            return;
+        }
+        structuralChange([&]() { addComponentsImpl<T>(entities, components); });
+    }
+
+    /**
+     * @brief Creates entities that all start with a copy of the same components
+     * @tparam Ts Component types of the new entities
+     * @param count Number of entities to create
+     * @param prototype Component values copied into every new entity
+     * @return The new entity handles
+     *
+     * Example: `coordinator.spawn(10000, Position{}, Velocity{0, -9.8f})`.
+     * Entities, storages, signatures and system membership are all handled in bulk
+     * under a single acquisition of the ECS mutex. With async modifications the
+     * entities are created immediately and the components are added at flush time.
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename... Ts>
+    std::vector<Entity> spawn(std::size_t count, const Ts &...prototype) {
+        static_assert(sizeof...(Ts) > 0, "spawn needs at least one component");
+        requireSyncPoint("spawn");
+        if (deferStructuralChanges()) {
+            std::vector<Entity> entities = createEntities(count);
+            (addComponents<Ts>(entities, std::vector<Ts>(count, prototype)), ...);
+            return entities;
+        }
+        std::vector<Entity> entities(count);
+        structuralChange([&]() {
+            entityManager->createEntities(count, entities.data());
+            spawnImpl<Ts...>(entities, prototype...);
+        });
+        return entities;
     }
 
     /**
      * @brief Removes a component from an entity
      * @tparam T Component type to remove
      * @param entity Entity to remove the component from
+     *
+     * Deferred until flushCommands() when async modifications are enabled or during
+     * a parallel phase.
      */
     template <typename T>
     void removeComponent(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
-        componentManager->removeComponent<T>(entity);
-        auto signature = entityManager->getSignature(entity);
-        signature.set(componentManager->getComponentTypeID<T>(), false);
-        entityManager->setSignature(entity, signature);
-        systemManager->entitySignatureChanged(entity, signature);
+        if (deferStructuralChanges()) {
+            m_commands.push(CommandBuffer::CommandType::RemoveComponent, entity,
+                            componentManager->getComponentTypeID<T>(),
+                            [this, entity]() { removeComponentImpl<T>(entity); });
+            return;
+        }
+        removeComponentSync<T>(entity);
+    }
+
+    /**
+     * @brief Synchronously removes a component from an entity
+     * @tparam T Component type to remove
+     * @param entity Entity to remove the component from
+     *
+     * Always applied immediately, regardless of the async modifications setting.
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T>
+    void removeComponentSync(Entity entity) {
+        requireSyncPoint("removeComponentSync");
+        structuralChange([&]() { removeComponentImpl<T>(entity); });
+    }
+
+    /**
+     * @brief Registers a callback for every addition of a component type
+     * @tparam T Observed component type (registered)
+     * @param fn Callable taking (Entity, T &), or (Entity, SoARef<T>) for SoA components
+     * @return Handle for removeObserver()
+     *
+     * Fires for addComponent(), addComponents(), emplaceComponent() and spawn(), but
+     * not when the entity already owned a T. Events are delivered after the ECS mutex
+     * is released (at flush time for deferred changes, all events of a flush in one
+     * batch), so the callback may use the coordinator. An addition whose component is
+     * gone by delivery time is skipped. Register observers at initialization, like
+     * systems, never from a callback.
+     */
+    template <typename T, typename Fn>
+    ObserverID onAdd(Fn fn) {
+        return m_observers.connect(componentManager->getComponentTypeID<T>(), ComponentEvent::Added,
+                                   [this, fn = std::move(fn)](Entity entity) mutable {
+                                       if (ComponentPtr<T> component = tryGetComponent<T>(entity)) {
+                                           fn(entity, *component);
+                                       }
+                                   });
+    }
+
+    /**
+     * @brief Registers a callback for every removal of a component type
+     * @tparam T Observed component type (registered)
+     * @param fn Callable taking (Entity)
+     * @return Handle for removeObserver()
+     *
+     * Fires for removeComponent() and for every T owned by an entity given to
+     * destroyEntity() / destroyEntities(). Delivered like onAdd() events, so the
+     * component data is already gone: observers keep what they need (e.g. a physics
+     * body handle) keyed by entity.
+     */
+    template <typename T, typename Fn>
+    ObserverID onRemove(Fn fn) {
+        return m_observers.connect(componentManager->getComponentTypeID<T>(), ComponentEvent::Removed,
+                                   std::function<void(Entity)>(std::move(fn)));
+    }
+
+    /**
+     * @brief Unregisters an observer
+     * @param id Handle returned by onAdd() or onRemove()
+     */
+    void removeObserver(ObserverID id) {
+        m_observers.disconnect(id);
     }
 
     /**
@@ -166,34 +656,124 @@ public:
      * @tparam T Component type to retrieve
      * @param entity Entity owning the component
      * @param force If true, bypasses mutex lock for performance (use with caution)
-     * @return Reference to the component
+     * @return Reference to the component (a SoARef proxy for SoA components)
      */
     template <typename T>
-    T &getComponent(Entity entity, bool force = false) {
+    ComponentRef<T> getComponent(Entity entity, bool force = false) {
         if (force) {
             // Skip mutex lock if force=true (use with caution - only when thread safety is handled externally)
             return componentManager->getComponent<T>(entity);
         } else {
-            std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+            auto lock = readLock();
             return componentManager->getComponent<T>(entity);
         }
     }
 
+    /**
+     * @brief Gets a reference to a component the caller is about to modify
+     * @tparam T Component type to retrieve
+     * @param entity Entity owning the component
+     * @return Reference to the component, marked as changed at the current tick
+     * @throws std::out_of_range if the entity has no such component
+     *
+     * Same as getComponent() when the storage does not track changes (see
+     * enableChangeTracking()).
+     */
+    template <typename T>
+    ComponentRef<T> getComponentMut(Entity entity) {
+        auto lock = readLock();
+        return componentManager->getComponentMut<T>(entity);
+    }
+
+    /**
+     * @brief Marks the component of an entity as changed at the current tick
+     * @tparam T Component type
+     * @param entity Entity owning the component (ignored if it has none)
+     *
+     * For writes made through getComponent() references or views. No-op when the
+     * storage does not track changes.
+     */
+    template <typename T>
+    void markDirty(Entity entity) {
+        auto lock = readLock();
+        componentManager->markChanged<T>(entity);
+    }
+
+    /**
+     * @brief Enables per-entity added/changed ticks on the storage of a component type
+     * @tparam T Registered component type
+     *
+     * Required by the Changed<T> and Added<T> view terms. Components already stored
+     * count as added and changed at the current tick.
+     * @throws std::logic_error in archetype storage mode
+     * @throws std::out_of_range if the component type is not registered
+     */
+    template <typename T>
+    void enableChangeTracking() {
+        auto lock = writeLock();
+        componentManager->enableChangeTracking<T>();
+    }
+
+    /**
+     * @brief Starts a new change-detection tick
+     * @return The new current tick
+     *
+     * Additions and changes are stamped with the current tick, and view() keeps the
+     * Changed<T> / Added<T> entries of the current tick, so call this at the sync point
+     * that ends a frame once every consumer has seen the changes.
+     * @throws std::logic_error during a parallel phase
+     */
+    Tick advanceTick() {
+        requireSyncPoint("advanceTick");
+        auto lock = writeLock();
+        componentManager->setCurrentTick(++m_currentTick);
+        return m_currentTick;
+    }
+
+    /**
+     * @brief Gets the current change-detection tick
+     * @return Tick stamped on additions and changes
+     */
+    Tick getCurrentTick() const {
+        return m_currentTick;
+    }
+
     /**
      * @brief Safely tries to get a component
      * @tparam T Component type to retrieve
      * @param entity Entity to get component from
-     * @return Pointer to component, or nullptr if it doesn't exist
+     * @return Pointer to component (a SoAPtr for SoA components), or nullptr if it doesn't exist
      */
     template <typename T>
-    T *tryGetComponent(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+    ComponentPtr<T> tryGetComponent(Entity entity) {
+        auto lock = readLock();
         if (hasComponent<T>(entity, true)) {
-            return &getComponent<T>(entity, true);
+            return componentAddress<T>(getComponent<T>(entity, true));
         }
         return nullptr;
     }
 
+    /**
+     * @brief Gets the field columns of a SoA component type
+     * @tparam T Component type declaring a SoALayout (see SoA.hpp)
+     * @param force If true, bypasses mutex lock for performance (use with caution)
+     * @return One aligned span per field, parallel to the packed entity array, valid
+     *         until the next structural change of T (empty if T is not registered)
+     * @throws std::logic_error in archetype storage mode, where components stay whole in chunks
+     */
+    template <typename T>
+    SoASpan<T> columns(bool force = false) {
+        if (componentManager->getStorageMode() == StorageMode::Archetype) {
+            throw std::logic_error("Coordinator::columns is not available in archetype storage mode, use forEachChunk.");
+        }
+        if (force) {
+            auto *storage = componentManager->getComponentStorage<T>();
+            return storage ? storage->columns() : SoASpan<T>();
+        }
+        auto lock = readLock();
+        return columns<T>(true);
+    }
+
     /**
      * @brief Gets the type ID for a component
      * @tparam T Component type
@@ -201,7 +781,6 @@ public:
      */
     template <typename T>
     ComponentTypeID getComponentTypeID() {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
         return componentManager->getComponentTypeID<T>();
     }
 
@@ -220,7 +799,7 @@ public:
             auto compTypeID = componentManager->getComponentTypeID<T>();
             return signature.test(compTypeID);
         } else {
-            std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+            auto lock = readLock();
             auto signature = entityManager->getSignature(entity);
             auto compTypeID = componentManager->getComponentTypeID<T>();
             return signature.test(compTypeID);
@@ -237,7 +816,7 @@ public:
      */
     template <typename T1, typename T2>
     bool hasComponentPair(Entity entityA, Entity entityB) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = readLock();
         return (hasComponent<T1>(entityA, true) && hasComponent<T2>(entityB, true)) ||
                (hasComponent<T2>(entityA, true) && hasComponent<T1>(entityB, true));
     }
@@ -248,58 +827,506 @@ public:
      * @return Component signature for the entity
      */
     Signature getEntitySignature(Entity entity) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = readLock();
         return entityManager->getSignature(entity);
     }
 
     /**
      * @brief Gets all entities currently in the system
-     * @return Vector of all entity IDs
+     * @return Copy of the living entity list, O(living entities)
      */
     std::vector<Entity> getEntities() {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = readLock();
+        Span<const Entity> entities = entityManager->getEntities();
+        return std::vector<Entity>(entities.begin(), entities.end());
+    }
+
+    /**
+     * @brief Gets a non-owning view of all living entities, without copying
+     * @return Span over the dense alive list
+     *
+     * No lock is held while the span is used: it is only valid until the next entity
+     * creation or destruction (e.g. during a parallel phase, or from a single thread).
+     */
+    Span<const Entity> livingEntities() {
+        auto lock = readLock();
         return entityManager->getEntities();
     }
 
     /**
-     * @brief Retrieves all entities that have both specified component types
-     * @tparam T1 First component type to check for
-     * @tparam T2 Second component type to check for
-     * @return Vector containing all entities with both component types
+     * @brief Gets the number of living entities
+     * @return Living entity count
      */
-    template <typename T1, typename T2>
+    std::size_t getLivingEntityCount() {
+        auto lock = readLock();
+        return entityManager->getLivingEntityCount();
+    }
+
+    /**
+     * @brief Retrieves all entities that have every specified component type
+     * @tparam Ts Component types to check for
+     * @return Vector containing all entities with all the component types
+     */
+    template <typename... Ts>
     std::vector<Entity> getAllEntitiesWith() {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = readLock();
         std::vector<Entity> entitiesWithComponents;
-        for (auto entity : entityManager->getEntities()) {
-            if (hasComponent<T1>(entity, true) && hasComponent<T2>(entity, true)) {
-                entitiesWithComponents.push_back(entity);
-            }
+        if (componentManager->getStorageMode() == StorageMode::Archetype) {
+            forEachChunk<Ts...>([&entitiesWithComponents](std::size_t count, const Entity *entities, Ts *...) {
+                entitiesWithComponents.insert(entitiesWithComponents.end(), entities, entities + count);
+            });
+            return entitiesWithComponents;
         }
+        auto entities = view<Ts...>(exclude<>, true);
+        entitiesWithComponents.reserve(entities.sizeHint());
+        entities.each([&entitiesWithComponents](Entity entity, auto &&...) {
+            entitiesWithComponents.push_back(entity);
+        });
         return entitiesWithComponents;
     }
 
+    /**
+     * @brief Builds a view over every entity owning all of Ts... and none of Us...
+     * @tparam Ts Required component types, optionally wrapped in Changed<> or Added<>
+     * @tparam Us Excluded component types
+     * @param excluded Exclusion filter, e.g. `exclude<Frozen>`
+     * @param force If true, bypasses mutex lock for performance (use with caution)
+     * @return View yielding (Entity, Ts&...) tuples
+     *
+     * The mutex is only taken (shared) while the view is built; iteration reads the storages
+     * directly and takes no lock, so no structural change may happen concurrently.
+     * Changed<T> / Added<T> terms keep the entries of the current tick (see viewSince()).
+     * @throws std::logic_error in archetype storage mode (use forEachChunk instead)
+     */
+    template <typename... Ts, typename... Us>
+    View<Exclude<Us...>, Ts...> view(Exclude<Us...> excluded = {}, bool force = false) {
+        if (force) {
+            return viewSince<Ts...>(m_currentTick, excluded, true);
+        }
+        auto lock = readLock();
+        return viewSince<Ts...>(m_currentTick, excluded, true);
+    }
+
+    /**
+     * @brief Builds a view whose Changed<> / Added<> terms accept every tick since a given one
+     * @tparam Ts Required component types, optionally wrapped in Changed<> or Added<>
+     * @tparam Us Excluded component types
+     * @param since Oldest accepted tick, e.g. the tick a system last ran at
+     * @param excluded Exclusion filter, e.g. `exclude<Frozen>`
+     * @param force If true, bypasses mutex lock for performance (use with caution)
+     * @return View yielding (Entity, Ts&...) tuples
+     * @throws std::logic_error in archetype storage mode, or if a Changed<> / Added<> term
+     *         targets a storage without change tracking
+     */
+    template <typename... Ts, typename... Us>
+    View<Exclude<Us...>, Ts...> viewSince(Tick since, Exclude<Us...> excluded = {}, bool force = false) {
+        (void)excluded;
+        if (componentManager->getStorageMode() == StorageMode::Archetype) {
+            throw std::logic_error("Coordinator::view is not available in archetype storage mode, use forEachChunk.");
+        }
+        if (force) {
+            return View<Exclude<Us...>, Ts...>(
+                std::make_tuple(componentManager->getComponentStorage<ViewComponent<Ts>>()...),
+                std::make_tuple(componentManager->getComponentStorage<Us>()...), since);
+        }
+        auto lock = readLock();
+        return viewSince<Ts...>(since, excluded, true);
+    }
+
+    /**
+     * @brief Gets the owning group of Ts..., creating it on first use
+     * @tparam Ts Component types owned by the group
+     * @return Handle over the group, valid until shutdown()
+     * @throws std::logic_error in archetype storage mode, during a parallel phase, or
+     *         if one of Ts... is already owned by another group
+     * @throws std::out_of_range if a component type is not registered
+     *
+     * A group is a persistent query: the Coordinator updates it whenever an entity
+     * gains or loses one of Ts..., and keeps the members at the front of the packed
+     * arrays of every owned storage, in the same order. Iterating a group is then a
+     * lockstep walk with no sparse lookup:
+     * @code
+     * auto movers = coordinator.group<Position, Velocity>();
+     * movers.each([](Entity entity, Position &position, Velocity &velocity) { ... });
+     * @endcode
+     * Each component type can be owned by one group only. Creating a group reorders
+     * the owned storages, invalidating the views iterating them at that time.
+     */
+    template <typename... Ts>
+    Group<Ts...> group() {
+        requireSyncPoint("group");
+        auto lock = writeLock();
+        return componentManager->group<Ts...>();
+    }
+
+    /**
+     * @brief Calls a function for every archetype chunk holding all of Ts...
+     * @tparam Ts Required component types
+     * @param fn Callable taking (std::size_t count, const Entity *entities, Ts *...columns),
+     *           every array holding count contiguous elements, except for tags (see isTag):
+     *           their pointer refers to the single tagInstance<T>() and must not be indexed
+     *
+     * Only available in archetype storage mode (does nothing otherwise). No lock is taken,
+     * so no structural change may happen concurrently.
+     */
+    template <typename... Ts, typename Fn>
+    void forEachChunk(Fn &&fn) {
+        if (componentManager->getStorageMode() != StorageMode::Archetype) {
+            return;
+        }
+        Signature required;
+        (required.set(componentManager->getComponentTypeID<Ts>()), ...);
+
+        for (auto *archetype : componentManager->getArchetypeStorage().getArchetypes()) {
+            if (!archetype->getSignature().contains(required)) {
+                continue;
+            }
+            for (std::size_t i = 0; i < archetype->chunkCount(); ++i) {
+                Chunk &chunk = archetype->getChunk(i);
+                fn(chunk.size(), chunk.entities(),
+                   archetype->column<Ts>(chunk, componentManager->getComponentTypeID<Ts>())...);
+            }
+        }
+    }
+
     /**
      * @brief Sets the component signature for a system
      * @tparam T The system type
      * @param signature The component signature to assign to the system
      *
      * This determines which entities the system will process based on their components.
+     * Entities that already exist are re-tested, so every system only holds entities
+     * matching its signature (which destroyEntity() relies on).
      */
     template <typename T>
     void setSystemSignature(Signature signature) {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
+        auto lock = writeLock();
         systemManager->setSignature<T>(signature);
+        for (Entity entity : entityManager->getEntities()) {
+            systemManager->entitySignatureChanged(entity, entityManager->getSignature(entity));
+        }
+    }
+
+    /**
+     * @brief Creates or replaces the world singleton of a type
+     * @tparam T Singleton type, not necessarily a registered component
+     * @param args Arguments forwarded to the constructor of T
+     * @return Reference to the new value, valid until it is replaced or removed
+     *
+     * Singletons hold world-wide data without a dummy entity; cloneWorld() copies
+     * them, snapshots do not store them.
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T, typename... Args>
+    T &setSingleton(Args &&...args) {
+        requireSyncPoint("setSingleton");
+        auto lock = writeLock();
+        return m_singletons.set<T>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Gets the world singleton of a type
+     * @tparam T Singleton type
+     * @return Reference to the value
+     * @throws std::out_of_range if no singleton of this type is set
+     */
+    template <typename T>
+    T &getSingleton() {
+        auto lock = readLock();
+        return m_singletons.get<T>();
+    }
+
+    /**
+     * @brief Gets the world singleton of a type, if set
+     * @tparam T Singleton type
+     * @return Pointer to the value, or nullptr
+     */
+    template <typename T>
+    T *tryGetSingleton() {
+        auto lock = readLock();
+        return m_singletons.tryGet<T>();
+    }
+
+    /**
+     * @brief Checks whether the world singleton of a type is set
+     * @tparam T Singleton type
+     * @return True if set
+     */
+    template <typename T>
+    bool hasSingleton() {
+        auto lock = readLock();
+        return m_singletons.has<T>();
+    }
+
+    /**
+     * @brief Destroys the world singleton of a type
+     * @tparam T Singleton type (ignored if not set)
+     * @throws std::logic_error during a parallel phase
+     */
+    template <typename T>
+    void removeSingleton() {
+        requireSyncPoint("removeSingleton");
+        auto lock = writeLock();
+        m_singletons.remove<T>();
+    }
+
+    /**
+     * @brief Writes the whole world state to a versioned binary snapshot
+     * @param stream Destination, opened in binary mode
+     *
+     * Stores the entity slots, signatures, free list and alive list, then each
+     * component storage as one block per packed array (entities, components, ticks),
+     * tagged with the type name. System membership is derived from the signatures
+     * and rebuilt on load. Pending commands are not saved, and neither are Shared<T>
+     * components: loaded entities come back without them.
+     * @throws std::logic_error in archetype storage mode, or if a registered component
+     *         type (other than Shared<T>) is not trivially copyable and default-constructible
+     */
+    void saveSnapshot(std::ostream &stream) {
+        auto lock = readLock();
+        componentManager->checkSnapshotable();
+        SnapshotWriter writer(stream);
+        writer.write(SNAPSHOT_MAGIC);
+        writer.write(SNAPSHOT_VERSION);
+        writer.write(static_cast<std::uint32_t>(ENTITY_INDEX_BITS));
+        writer.write(static_cast<std::uint32_t>(MAX_COMPONENTS));
+        writer.write(m_currentTick);
+        entityManager->saveSnapshot(writer);
+        componentManager->saveSnapshot(writer);
+    }
+
+    /**
+     * @brief Replaces the whole world state with a snapshot written by saveSnapshot()
+     * @param stream Source, opened in binary mode
+     *
+     * Every component type of the snapshot must be registered (in any order: type IDs
+     * are remapped by name) and the capacity must hold its entity slots. Systems keep
+     * their registration and are refilled from the loaded signatures. Pending commands
+     * are discarded and no observer event is fired. If loading fails the world is left
+     * in an unspecified state and must be init() again.
+     * @throws std::runtime_error if the snapshot is truncated, incompatible or corrupted
+     *         (entity slots, or component owners that do not match the signatures)
+     * @throws std::logic_error during a parallel phase or in archetype storage mode
+     */
+    void loadSnapshot(std::istream &stream) {
+        requireSyncPoint("loadSnapshot");
+        m_commands.drain();
+        auto lock = writeLock();
+        SnapshotReader reader(stream);
+        reader.expect(SNAPSHOT_MAGIC, "file (bad magic number)");
+        reader.expect(SNAPSHOT_VERSION, "snapshot version");
+        reader.expect(static_cast<std::uint32_t>(ENTITY_INDEX_BITS), "entity index bits");
+        reader.expect(static_cast<std::uint32_t>(MAX_COMPONENTS), "component count");
+        m_currentTick = reader.read<Tick>();
+        componentManager->setCurrentTick(m_currentTick);
+        entityManager->loadSnapshot(reader);
+        auto remap = componentManager->loadSnapshot(reader, *entityManager);
+
+        systemManager->clearEntities();
+        for (Entity entity : entityManager->getEntities()) {
+            Signature saved = entityManager->getSignature(entity);
+            Signature signature;
+            forEachSetBit(saved, [&](ComponentTypeID type) { signature.set(remap[type]); });
+            entityManager->setSignature(entity, signature);
+            systemManager->entitySignatureChanged(entity, Signature{}, signature);
+        }
+    }
+
+    /**
+     * @brief Makes another coordinator an exact copy of this world
+     * @param target Coordinator receiving the copy, initialized in sparse-set storage mode
+     *
+     * Entities (with the same handles), signatures, components and change ticks are
+     * copied as whole arrays, one bulk copy per storage. The arrays and pages the
+     * target already holds are reused, so cloning into the same target every frame
+     * (e.g. for speculative simulation) stops allocating once it has grown. Component
+     * types missing from the target are registered on it. The target keeps its own
+     * systems, refilled from the copied signatures, and its own observers (no event
+     * is fired); its pending commands are discarded. Singletons are deep-copied. If
+     * cloning fails the target is left in an unspecified state and must be init() again.
+     * @throws std::logic_error in archetype storage mode, during a parallel phase of
+     *         the target, or if a component or singleton type is not copyable
+     */
+    void cloneWorld(Coordinator &target) {
+        if (&target == this) {
+            return;
+        }
+        target.requireSyncPoint("cloneWorld");
+        target.m_commands.drain();
+        std::shared_lock<std::shared_mutex> sourceLock(m_ecsMutex, std::defer_lock);
+        std::unique_lock<std::shared_mutex> targetLock(target.m_ecsMutex, std::defer_lock);
+        std::lock(sourceLock, targetLock);
+
+        target.m_singletons.copyFrom(m_singletons);
+        target.componentManager->copyFrom(*componentManager);
+        target.entityManager->copyFrom(*entityManager);
+        target.m_currentTick = m_currentTick;
+        target.systemManager->clearEntities();
+        for (Entity entity : target.entityManager->getEntities()) {
+            target.systemManager->entitySignatureChanged(entity, Signature{}, target.entityManager->getSignature(entity));
+        }
+    }
+
+    /**
+     * @brief Moves entities, with all their components, to another world
+     * @param entities Entities of this world to move (stale handles are skipped)
+     * @param target Destination world, in sparse-set storage mode
+     * @return The handle of each moved entity in target, NULL_ENTITY for skipped handles
+     *
+     * Each component is moved with one storage-to-storage transfer, and the entities
+     * leave the systems of this world for those of the target. No observer event is
+     * fired in either world: the components change worlds, they are not destroyed
+     * and re-created.
+     * @throws std::logic_error in archetype storage mode, during a parallel phase of
+     *         either world, if target is this world, or (before moving anything) if a
+     *         component type is not registered in target
+     * @throws std::runtime_error (before moving anything) if target lacks capacity
+     */
+    std::vector<Entity> moveEntities(Span<const Entity> entities, Coordinator &target) {
+        if (&target == this) {
+            throw std::logic_error("Coordinator::moveEntities: the target must be another world.");
+        }
+        requireSyncPoint("moveEntities");
+        target.requireSyncPoint("moveEntities");
+        if (componentManager->getStorageMode() == StorageMode::Archetype ||
+            target.componentManager->getStorageMode() == StorageMode::Archetype) {
+            throw std::logic_error("Coordinator::moveEntities requires sparse-set storage.");
+        }
+        std::unique_lock<std::shared_mutex> sourceLock(m_ecsMutex, std::defer_lock);
+        std::unique_lock<std::shared_mutex> targetLock(target.m_ecsMutex, std::defer_lock);
+        std::lock(sourceLock, targetLock);
+
+        Signature used;
+        std::size_t count = 0;
+        for (Entity entity : entities) {
+            if (entityManager->entityExists(entity)) {
+                used |= entityManager->getSignature(entity);
+                ++count;
+            }
+        }
+        if (!target.componentManager->getRegisteredTypes().contains(used)) {
+            throw std::logic_error("Coordinator::moveEntities: a component type is not registered in the target world.");
+        }
+        if (count > target.entityManager->getCapacity() - target.entityManager->getLivingEntityCount()) {
+            throw std::runtime_error("Coordinator::moveEntities: not enough entity capacity in the target world.");
+        }
+
+        std::vector<Entity> moved(entities.size(), NULL_ENTITY);
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            Entity entity = entities[i];
+            if (!entityManager->entityExists(entity)) {
+                continue;
+            }
+            Signature signature = entityManager->getSignature(entity);
+            Entity handle = target.entityManager->createEntity();
+            componentManager->transferEntity(entity, signature, *target.componentManager, handle);
+            target.entityManager->setSignature(handle, signature);
+            target.systemManager->entitySignatureChanged(handle, Signature{}, signature);
+            systemManager->entityDestroyed(entity, signature);
+            entityManager->destroyEntity(entity);
+            moved[i] = handle;
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Enables or disables deferred structural modifications
+     * @param async If true, destroyEntity/addComponent/removeComponent are queued
+     *              until flushCommands(); if false they apply immediately
+     *
+     * Disabling async modifications flushes any command still pending.
+     */
+    void setAsyncModifications(bool async) {
+        m_asyncModifications.store(async, std::memory_order_release);
+        if (!async) {
+            flushCommands();
+        }
+    }
+
+    /**
+     * @brief Checks whether structural modifications are deferred
+     * @return True if async modifications are enabled
+     */
+    bool isAsyncModifications() const {
+        return m_asyncModifications.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Applies every queued modification
+     *
+     * Redundant commands are coalesced first, then the remaining ones are applied
+     * in recording order under a single acquisition of the ECS mutex. The observer
+     * events of the whole batch are delivered afterwards, once the mutex is released.
+     *
+     * If a command throws, the commands applied before it stay applied and their
+     * events are still delivered, the failing command is dropped, and the commands
+     * after it are queued again (ahead of any new one) for the next flush. The
+     * exception is then rethrown.
+     * @throws std::logic_error during a parallel phase (use endParallelPhase())
+     */
+    void flushCommands() {
+        requireSyncPoint("flushCommands");
+        if (m_commands.size() == 0) {
+            return;
+        }
+        auto commands = m_commands.drain();
+        std::exception_ptr failure;
+        structuralChange([&]() {
+            std::size_t next = 0;
+            try {
+                for (; next < commands.size(); ++next) {
+                    commands[next].apply();
+                }
+            } catch (...) {
+                failure = std::current_exception();
+                m_commands.requeue(commands, next + 1);
+            }
+        });
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    /**
+     * @brief Starts a parallel phase: reads become lock-free, structural changes are deferred
+     *
+     * Waits for in-flight operations holding the ECS mutex. Component data may still
+     * be written in place through getComponent() references, following the access
+     * declared with setSystemAccess().
+     * @throws std::logic_error if a parallel phase is already running
+     */
+    void beginParallelPhase() {
+        auto lock = writeLock();
+        if (m_parallelPhase.exchange(true, std::memory_order_acq_rel)) {
+            throw std::logic_error("Coordinator::beginParallelPhase: a parallel phase is already running.");
+        }
+    }
+
+    /**
+     * @brief Ends the parallel phase and applies the commands recorded during it
+     *
+     * Must be called once every thread reading the coordinator during the phase is
+     * done (e.g. after runFrame() returned).
+     */
+    void endParallelPhase() {
+        m_parallelPhase.store(false, std::memory_order_release);
+        flushCommands();
+    }
+
+    /**
+     * @brief Checks whether a parallel phase is running
+     * @return True between beginParallelPhase() and endParallelPhase()
+     */
+    bool isParallelPhase() const {
+        return m_parallelPhase.load(std::memory_order_acquire);
     }
 
     /**
      * @brief Gets the number of commands waiting in the queue
-     * @return Current command count (currently always returns 0)
-     * @note Command queue functionality is not yet implemented
+     * @return Current command count, before coalescing
      */
     int getEnqueuedCommandsCount() {
-        std::lock_guard<std::shared_mutex> lock(m_ecsMutex);
-        return 0;
+        return static_cast<int>(m_commands.size());
     }
 
     /**
@@ -321,4 +1348,250 @@ private:
 
     /// Mutex for ensuring thread-safe operations across the ECS
     std::shared_mutex m_ecsMutex;
+
+    /// Queue of deferred structural modifications
+    CommandBuffer m_commands;
+
+    /// Lifecycle observers and their pending events
+    ObserverRegistry m_observers;
+
+    /// World singletons, see setSingleton()
+    SingletonRegistry m_singletons;
+
+    /// Tick stamped on component additions and changes
+    Tick m_currentTick{1};
+
+    /// Whether structural modifications are deferred to flushCommands()
+    std::atomic_bool m_asyncModifications{false};
+    std::atomic_bool m_parallelPhase{false};
+
+    /**
+     * @brief Locks the ECS mutex for a read-only operation
+     * @return Shared lock, left unlocked during a parallel phase (no structural change can happen)
+     */
+    std::shared_lock<std::shared_mutex> readLock() {
+        if (m_parallelPhase.load(std::memory_order_acquire)) {
+            return std::shared_lock<std::shared_mutex>(m_ecsMutex, std::defer_lock);
+        }
+#if ECS_ENABLE_PROFILING
+        Profiler::Clock::time_point begin = Profiler::Clock::now();
+        std::shared_lock<std::shared_mutex> lock(m_ecsMutex);
+        Profiler::global().addLockWait(Profiler::Clock::now() - begin);
+        return lock;
+#else
+        return std::shared_lock<std::shared_mutex>(m_ecsMutex);
+#endif
+    }
+
+    /**
+     * @brief Locks the ECS mutex for a structural change
+     * @return Exclusive lock
+     */
+    std::unique_lock<std::shared_mutex> writeLock() {
+#if ECS_ENABLE_PROFILING
+        Profiler::Clock::time_point begin = Profiler::Clock::now();
+        std::unique_lock<std::shared_mutex> lock(m_ecsMutex);
+        Profiler::global().addLockWait(Profiler::Clock::now() - begin);
+        return lock;
+#else
+        return std::unique_lock<std::shared_mutex>(m_ecsMutex);
+#endif
+    }
+
+    /**
+     * @brief Applies a structural change under the ECS mutex, then delivers its observer events
+     * @param fn Callable applying the change
+     * @return Result of fn
+     */
+    template <typename Fn>
+    std::invoke_result_t<Fn &> structuralChange(Fn &&fn) {
+        ObserverRegistry::Events events;
+        if constexpr (std::is_void_v<std::invoke_result_t<Fn &>>) {
+            {
+                auto lock = writeLock();
+                fn();
+                events = m_observers.takePending();
+            }
+            m_observers.dispatch(events);
+        } else {
+            std::invoke_result_t<Fn &> result;
+            {
+                auto lock = writeLock();
+                result = fn();
+                events = m_observers.takePending();
+            }
+            m_observers.dispatch(events);
+            return result;
+        }
+    }
+
+    /**
+     * @brief Checks whether destroyEntity/addComponent/removeComponent must be recorded
+     * @return True if async modifications are enabled or a parallel phase is running
+     */
+    bool deferStructuralChanges() const {
+        return m_asyncModifications.load(std::memory_order_acquire) ||
+               m_parallelPhase.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Rejects an immediate structural change during a parallel phase
+     * @param operation Name of the rejected operation, used in the error message
+     * @throws std::logic_error during a parallel phase
+     */
+    void requireSyncPoint(const char *operation) const {
+        if (m_parallelPhase.load(std::memory_order_acquire)) {
+            throw std::logic_error(std::string("Coordinator::") + operation + " is not allowed during a parallel phase.");
+        }
+    }
+
+    /**
+     * @brief Destroys an entity across all managers
+     * @param entity Entity ID to destroy
+     * @note Caller must hold m_ecsMutex
+     *
+     * Stale handles (destroyed entity, recycled slot) are ignored. Only the storages of
+     * the entity's components and the systems matching its signature are visited.
+     */
+    void destroyEntityImpl(Entity entity) {
+        if (!entityManager->entityExists(entity)) {
+            return;
+        }
+        Signature signature = entityManager->getSignature(entity);
+        m_observers.record(entity, signature, ComponentEvent::Removed);
+        entityManager->destroyEntity(entity);
+        componentManager->entityDestroyed(entity, signature);
+        systemManager->entityDestroyed(entity, signature);
+    }
+
+    /**
+     * @brief Adds a component and updates the entity signature
+     * @tparam T Component type to add
+     * @param entity Entity to add the component to
+     * @param args Arguments forwarded to the constructor of T
+     * @return Pointer to the new (or already present) component, nullptr for a stale handle
+     * @note Caller must hold m_ecsMutex
+     *
+     * Stale handles (destroyed entity, recycled slot) are ignored.
+     */
+    template <typename T, typename... Args>
+    ComponentPtr<T> addComponentImpl(Entity entity, Args &&...args) {
+        if (!entityManager->entityExists(entity)) {
+            return nullptr;
+        }
+        ComponentRef<T> component = componentManager->emplaceComponent<T>(entity, std::forward<Args>(args)...);
+        ComponentTypeID type = componentManager->getComponentTypeID<T>();
+        auto oldSignature = entityManager->getSignature(entity);
+        if (oldSignature.test(type)) {
+            return componentAddress<T>(component);
+        }
+        auto signature = oldSignature;
+        signature.set(type, true);
+        entityManager->setSignature(entity, signature);
+        systemManager->entitySignatureChanged(entity, oldSignature, signature);
+        m_observers.record(entity, type, ComponentEvent::Added);
+        return componentAddress<T>(component);
+    }
+
+    /**
+     * @brief Adds a component to each entity of a batch and updates signatures in bulk
+     * @tparam T Component type to add
+     * @param entities Entities to add the component to
+     * @param components Component of each entity, parallel to entities
+     * @note Caller must hold m_ecsMutex
+     *
+     * Stale handles and entities already owning a T are skipped.
+     */
+    template <typename T>
+    void addComponentsImpl(Span<const Entity> entities, Span<const T> components) {
+        ComponentTypeID type = componentManager->getComponentTypeID<T>();
+        if (auto *storage = componentManager->getComponentStorage<T>()) {
+            storage->reserve(storage->size() + entities.size());
+        }
+        std::vector<Entity> changed;
+        std::vector<Signature> oldSignatures;
+        std::vector<Signature> newSignatures;
+        changed.reserve(entities.size());
+        oldSignatures.reserve(entities.size());
+        newSignatures.reserve(entities.size());
+
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            Entity entity = entities[i];
+            if (!entityManager->entityExists(entity)) {
+                continue;
+            }
+            auto signature = entityManager->getSignature(entity);
+            if (signature.test(type)) {
+                continue;
+            }
+            componentManager->emplaceComponent<T>(entity, components[i]);
+            oldSignatures.push_back(signature);
+            signature.set(type);
+            entityManager->setSignature(entity, signature);
+            newSignatures.push_back(signature);
+            changed.push_back(entity);
+            m_observers.record(entity, type, ComponentEvent::Added);
+        }
+        systemManager->entitySignaturesChanged(changed, oldSignatures, newSignatures);
+    }
+
+    /**
+     * @brief Gives freshly created entities a copy of the prototype components
+     * @tparam Ts Component types
+     * @param entities New entities, without any component yet
+     * @param prototype Component values copied into every entity
+     * @note Caller must hold m_ecsMutex
+     */
+    template <typename... Ts>
+    void spawnImpl(Span<const Entity> entities, const Ts &...prototype) {
+        Signature signature;
+        (signature.set(componentManager->getComponentTypeID<Ts>()), ...);
+        (insertCopies<Ts>(entities, prototype), ...);
+        for (Entity entity : entities) {
+            entityManager->setSignature(entity, signature);
+            m_observers.record(entity, signature, ComponentEvent::Added);
+        }
+        std::vector<Signature> oldSignatures(entities.size());
+        std::vector<Signature> newSignatures(entities.size(), signature);
+        systemManager->entitySignaturesChanged(entities, oldSignatures, newSignatures);
+    }
+
+    /**
+     * @brief Inserts a copy of a component for every entity of a batch
+     * @note Caller must hold m_ecsMutex; signatures are left untouched
+     */
+    template <typename T>
+    void insertCopies(Span<const Entity> entities, const T &component) {
+        if (auto *storage = componentManager->getComponentStorage<T>()) {
+            storage->reserve(storage->size() + entities.size());
+        }
+        for (Entity entity : entities) {
+            componentManager->emplaceComponent<T>(entity, component);
+        }
+    }
+
+    /**
+     * @brief Removes a component and updates the entity signature
+     * @tparam T Component type to remove
+     * @param entity Entity to remove the component from
+     * @note Caller must hold m_ecsMutex
+     *
+     * Stale handles (destroyed entity, recycled slot) are ignored.
+     */
+    template <typename T>
+    void removeComponentImpl(Entity entity) {
+        if (!entityManager->entityExists(entity)) {
+            return;
+        }
+        componentManager->removeComponent<T>(entity);
+        ComponentTypeID type = componentManager->getComponentTypeID<T>();
+        auto oldSignature = entityManager->getSignature(entity);
+        if (oldSignature.test(type)) {
+            m_observers.record(entity, type, ComponentEvent::Removed);
+        }
+        auto signature = oldSignature;
+        signature.set(type, false);
+        entityManager->setSignature(entity, signature);
+        systemManager->entitySignatureChanged(entity, oldSignature, signature);
+    }
 };
@@ -1,11 +1,27 @@
 #pragma once
 
 #include "Types.hpp"
+#include "Span.hpp"
+#include "Snapshot.hpp"
+#include "SoA.hpp"
+#include "EntitySet.hpp"
 #include "EntityManager.hpp"
 #include "AComponentStorage.hpp"
 #include "ComponentStorage.hpp"
+#include "ComponentType.hpp"
+#include "Group.hpp"
+#include "Shared.hpp"
+#include "Tag.hpp"
+#include "ArchetypeStorage.hpp"
 #include "ComponentManager.hpp"
+#include "View.hpp"
+#include "CommandBuffer.hpp"
+#include "Observer.hpp"
+#include "Profiler.hpp"
+#include "ThreadPool.hpp"
 #include "SystemManager.hpp"
 #include "Coordinator.hpp"
+#include "World.hpp"
+#include "WorldArena.hpp"
 
 extern Coordinator gCoordinator;
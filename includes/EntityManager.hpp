@@ -1,9 +1,15 @@
 #pragma once
 
-#include <queue>
+#include <algorithm>
 #include <array>
-#include <bitset>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <vector>
+#include "EntitySet.hpp"
+#include "Snapshot.hpp"
+#include "Span.hpp"
 #include "Types.hpp"
 #include <iostream>
 #include <string>
@@ -11,99 +17,346 @@
 /**
  * @class EntityManager
  * @brief Manages the creation and destruction of entities.
+ *
+ * Entities are generational handles (see entityIndex() / entityGeneration()). Each
+ * slot stores the handle currently living in it, so checking a handle is a single
+ * compare. Destroying an entity bumps the slot generation and pushes the slot onto
+ * an intrusive free list threaded through the free slots themselves; fresh slots
+ * come from a counter, so no up-front fill is needed. Slots are stored in
+ * fixed-size pages that are only allocated once an entity of the page is created.
+ * Living entities are also kept in a dense EntitySet, so iterating them costs
+ * O(living entities) whatever the capacity.
  */
 class EntityManager
 {
     public:
-        EntityManager()
+        /** Number of slots per page */
+        static constexpr Entity PAGE_SIZE = 4096;
+
+        /**
+         * @brief Creates an entity manager.
+         * @param capacity Maximum number of living entities.
+         * @param resource Memory resource the slot pages are allocated from.
+         * @throws std::invalid_argument if the capacity does not fit in the entity index bits.
+         */
+        explicit EntityManager(Entity capacity = MAX_ENTITIES,
+                               std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : pages(resource), alive(resource), capacity(capacity)
         {
-            for (Entity entity = 0; entity < MAX_ENTITIES; ++entity)
-            {
-                availableEntities.push(entity);
+            if (capacity >= ENTITY_INDEX_MASK) {
+                throw std::invalid_argument("Entity capacity " + std::to_string(capacity) + " does not fit in " + std::to_string(ENTITY_INDEX_BITS) + " index bits.");
             }
+            pages.resize((static_cast<std::size_t>(capacity) + PAGE_SIZE - 1) / PAGE_SIZE);
         }
 
         /**
          * @brief Creates a new entity.
-         * @return The new entity ID.
+         * @return The new entity handle.
+         *
+         * The most recently freed slot is reused first, with its bumped generation.
          */
         Entity createEntity()
         {
-            if (livingEntityCount >= MAX_ENTITIES) {
-                throw std::runtime_error("Too many entities in existence. ( " + std::to_string(livingEntityCount) + " / " + std::to_string(MAX_ENTITIES) + " )");
+            if (livingEntityCount >= capacity) {
+                throw std::runtime_error("Too many entities in existence. ( " + std::to_string(livingEntityCount) + " / " + std::to_string(capacity) + " )");
+            }
+            Entity id;
+            if (freeList != ENTITY_INDEX_MASK) {
+                Entity index = freeList;
+                Entity &slot = slotOf(index);
+                freeList = entityIndex(slot);
+                id = makeEntity(index, entityGeneration(slot));
+                slot = id;
+            } else {
+                Entity index = nextEntity++;
+                ensurePage(index);
+                id = makeEntity(index, 0);
+                slotOf(index) = id;
             }
-            Entity id = availableEntities.front();
-            availableEntities.pop();
+            alive.insert(id);
             ++livingEntityCount;
             return id;
         }
 
+        /**
+         * @brief Creates several entities at once.
+         * @param count Number of entities to create.
+         * @param out Receives the count new entity handles.
+         * @throws std::runtime_error (before creating any) if the capacity would be exceeded.
+         */
+        void createEntities(std::size_t count, Entity *out)
+        {
+            if (count > capacity - livingEntityCount) {
+                throw std::runtime_error("Too many entities in existence. ( " + std::to_string(livingEntityCount) + " + " + std::to_string(count) + " / " + std::to_string(capacity) + " )");
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = createEntity();
+            }
+        }
+
         /**
          * @brief Destroys an entity.
          * @param entity The entity to destroy.
+         *
+         * Stale or unknown handles are ignored.
          */
         void destroyEntity(Entity entity)
         {
-            if (signatures[entity].none()) {
+            if (!entityExists(entity)) {
                 return;
             }
-            if (livingEntityCount <= 0) {
-                throw std::runtime_error("No entities to destroy.");
-            }
-            signatures[entity].reset();
-            availableEntities.push(entity);
+            Entity index = entityIndex(entity);
+            signatureOf(index).reset();
+            slotOf(index) = makeEntity(freeList, entityGeneration(entity) + 1);
+            freeList = index;
+            alive.erase(entity);
             --livingEntityCount;
         }
 
         /**
          * @brief Checks if an entity exists.
          * @param entity The entity.
-         * @return True if the entity exists.
+         * @return True if the handle refers to a living entity (same slot and generation).
          */
         bool entityExists(Entity entity)
         {
-            return entity < MAX_ENTITIES && signatures[entity].any();
+            Entity index = entityIndex(entity);
+            return index < nextEntity && slotOf(index) == entity;
         }
 
         /**
-         * @brief Retrieves all entities.
-         * @return A vector of all entities.
+         * @brief Retrieves all living entities.
+         * @return Non-owning view of the dense alive list, valid until the next
+         *         entity creation or destruction (order is not stable).
          */
-        std::vector<Entity> getEntities()
+        Span<const Entity> getEntities() const
         {
-            std::vector<Entity> entities;
-            for (Entity entity = 0; entity < MAX_ENTITIES; ++entity)
-            {
-                if (entityExists(entity))
-                {
-                    entities.push_back(entity);
-                }
-            }
-            return entities;
+            return alive.span();
+        }
+
+        /**
+         * @brief Gets the number of living entities.
+         * @return Living entity count.
+         */
+        std::size_t getLivingEntityCount() const
+        {
+            return alive.size();
         }
 
         /**
          * @brief Sets the signature of an entity.
          * @param entity The entity.
          * @param signature The signature to set.
+         *
+         * Ignored if the handle does not refer to a living entity.
          */
         void setSignature(Entity entity, Signature signature)
         {
-            signatures[entity] = signature;
+            if (entityExists(entity)) {
+                signatureOf(entityIndex(entity)) = signature;
+            }
         }
 
         /**
          * @brief Gets the signature of an entity.
          * @param entity The entity.
-         * @return The signature of the entity.
+         * @return The signature of the entity (empty if the handle is not alive).
          */
         Signature getSignature(Entity entity)
         {
-            return signatures[entity];
+            if (!entityExists(entity)) {
+                return Signature{};
+            }
+            return signatureOf(entityIndex(entity));
+        }
+
+        /**
+         * @brief Gets the maximum number of living entities.
+         * @return The entity capacity.
+         */
+        Entity getCapacity() const
+        {
+            return capacity;
+        }
+
+        /**
+         * @brief Replaces the whole state with a copy of another manager's.
+         * @param source The manager to copy, whose capacity is adopted.
+         *
+         * Pages already allocated here are reused, so copying repeatedly into the same
+         * manager stops allocating once it has grown.
+         */
+        void copyFrom(const EntityManager &source)
+        {
+            if (&source == this) {
+                return;
+            }
+            capacity = source.capacity;
+            pages.resize(source.pages.size());
+            for (std::size_t i = 0; i < pages.size(); ++i)
+            {
+                if (!source.pages[i]) {
+                    pages[i].reset();
+                    continue;
+                }
+                ensurePage(static_cast<Entity>(i * PAGE_SIZE));
+                *pages[i] = *source.pages[i];
+            }
+            alive = source.alive;
+            nextEntity = source.nextEntity;
+            freeList = source.freeList;
+            livingEntityCount = source.livingEntityCount;
+        }
+
+        /**
+         * @brief Writes the slots, signatures, free list and alive list to a snapshot.
+         * @param writer The snapshot writer.
+         */
+        void saveSnapshot(SnapshotWriter &writer) const
+        {
+            writer.write(nextEntity);
+            writer.write(freeList);
+            for (Entity first = 0; first < nextEntity; first += PAGE_SIZE)
+            {
+                const Page &page = *pages[first / PAGE_SIZE];
+                std::size_t count = std::min<std::size_t>(PAGE_SIZE, nextEntity - first);
+                writer.writeArray(page.slots, count);
+                writer.writeArray(page.signatures, count);
+            }
+            writer.write(static_cast<std::uint32_t>(alive.size()));
+            writer.writeArray(alive.data(), alive.size());
+        }
+
+        /**
+         * @brief Replaces the whole state with the one of a snapshot.
+         * @param reader The snapshot reader.
+         * @throws std::runtime_error if the snapshot does not fit in the capacity, or if
+         *         its free list or alive list is inconsistent with its slots.
+         *
+         * The free list must only link loaded slots, end with ENTITY_INDEX_MASK and have
+         * no cycle; every alive entity must match its slot; free and living slots must
+         * account for every loaded slot. A corrupt snapshot thus cannot make later
+         * createEntity() calls index past the loaded slots or loop on the free list.
+         */
+        void loadSnapshot(SnapshotReader &reader)
+        {
+            Entity used = reader.read<Entity>();
+            Entity head = reader.read<Entity>();
+            if (used > capacity) {
+                throw std::runtime_error("Snapshot: " + std::to_string(used) + " entity slots exceed the capacity (" + std::to_string(capacity) + ").");
+            }
+            for (auto &page : pages)
+            {
+                page.reset();
+            }
+            for (Entity first = 0; first < used; first += PAGE_SIZE)
+            {
+                ensurePage(first);
+                Page &page = *pages[first / PAGE_SIZE];
+                std::size_t count = std::min<std::size_t>(PAGE_SIZE, used - first);
+                reader.readArray(page.slots, count);
+                reader.readArray(page.signatures, count);
+            }
+            nextEntity = used;
+            freeList = ENTITY_INDEX_MASK;
+            livingEntityCount = 0;
+            alive.clear();
+
+            std::vector<bool> isFree(used, false);
+            std::size_t freeCount = 0;
+            for (Entity index = head; index != ENTITY_INDEX_MASK; index = entityIndex(slotOf(index)))
+            {
+                if (index >= used || isFree[index]) {
+                    throw std::runtime_error("Snapshot: corrupted free list.");
+                }
+                isFree[index] = true;
+                ++freeCount;
+            }
+            std::uint32_t living = reader.read<std::uint32_t>();
+            if (living > used || freeCount + living != used) {
+                throw std::runtime_error("Snapshot: corrupted alive list.");
+            }
+            alive.reserve(living);
+            for (std::uint32_t i = 0; i < living; ++i)
+            {
+                Entity entity = reader.read<Entity>();
+                Entity index = entityIndex(entity);
+                if (index >= used || isFree[index] || slotOf(index) != entity || !alive.insert(entity)) {
+                    alive.clear();
+                    throw std::runtime_error("Snapshot: corrupted alive list.");
+                }
+            }
+            freeList = head;
+            livingEntityCount = living;
         }
 
     private:
-        std::queue<Entity> availableEntities{};
-        std::array<Signature, MAX_ENTITIES> signatures{};
+        /**
+         * @struct Page
+         * @brief Fixed-size block of entity slots.
+         *
+         * A living slot holds its own handle; a free slot holds the index of the next
+         * free slot and the generation its next entity will get.
+         */
+        struct Page
+        {
+            Signature signatures[PAGE_SIZE]{};
+            Entity slots[PAGE_SIZE]{};
+        };
+
+        /**
+         * @struct PageDeleter
+         * @brief Returns a page to the memory resource it was allocated from.
+         */
+        struct PageDeleter
+        {
+            std::pmr::memory_resource *resource;
+
+            void operator()(Page *page) const
+            {
+                page->~Page();
+                resource->deallocate(page, sizeof(Page), alignof(Page));
+            }
+        };
+
+        std::pmr::vector<std::unique_ptr<Page, PageDeleter>> pages;
+        EntitySet alive;
+        Entity capacity{};
+        Entity nextEntity{};
+        Entity freeList{ENTITY_INDEX_MASK};
         std::uint32_t livingEntityCount{};
+
+        /**
+         * @brief Allocates the page holding a slot, if needed.
+         * @param index The slot index.
+         * @throws std::out_of_range if the slot is beyond the capacity.
+         */
+        void ensurePage(Entity index)
+        {
+            if (index >= capacity) {
+                throw std::out_of_range("Entity " + std::to_string(index) + " is beyond the entity capacity (" + std::to_string(capacity) + ").");
+            }
+            auto &page = pages[index / PAGE_SIZE];
+            if (!page) {
+                std::pmr::memory_resource *resource = pages.get_allocator().resource();
+                void *memory = resource->allocate(sizeof(Page), alignof(Page));
+                page = std::unique_ptr<Page, PageDeleter>(new (memory) Page(), PageDeleter{resource});
+            }
+        }
+
+        /**
+         * @brief Accesses a slot whose page is allocated.
+         */
+        Entity &slotOf(Entity index)
+        {
+            return pages[index / PAGE_SIZE]->slots[index % PAGE_SIZE];
+        }
+
+        /**
+         * @brief Accesses the signature of a slot whose page is allocated.
+         */
+        Signature &signatureOf(Entity index)
+        {
+            return pages[index / PAGE_SIZE]->signatures[index % PAGE_SIZE];
+        }
 };
@@ -0,0 +1,175 @@
+/**
+ * @file EntitySet.hpp
+ * @brief Sparse set of entities with O(1) insertion, removal and lookup
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Span.hpp"
+#include "Types.hpp"
+
+/**
+ * @class EntitySet
+ * @brief Dense array of entities indexed by a sparse array
+ *
+ * Entities are packed contiguously (cheap to iterate and to split into ranges), and
+ * a sparse array indexed by entity slot index stores each entity's packed position.
+ * Lookups compare the full handle, so stale handles (older generation) never match.
+ * Removal moves the last entity into the freed position (swap-and-pop), so the
+ * order of the packed array is not stable.
+ *
+ * Both arrays allocate from a std::pmr::memory_resource (the default resource
+ * unless one is given), so a world can back its sets with an arena.
+ */
+class EntitySet {
+public:
+    /** Marker for an entity that is not part of the set */
+    static constexpr Entity npos = std::numeric_limits<Entity>::max();
+
+    /**
+     * @brief Creates an empty set
+     * @param resource Memory resource backing the arrays
+     */
+    explicit EntitySet(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : _dense(resource), _sparse(resource) {}
+
+    /**
+     * @brief Moves the arrays to another memory resource, keeping the content
+     * @param resource New memory resource backing the arrays
+     */
+    void setMemoryResource(std::pmr::memory_resource *resource) {
+        std::pmr::vector<Entity> dense(_dense.begin(), _dense.end(), resource);
+        std::pmr::vector<Entity> sparse(_sparse.begin(), _sparse.end(), resource);
+        // Allocators of pmr containers never propagate on assignment: rebuild in place
+        _dense.~vector();
+        new (&_dense) std::pmr::vector<Entity>(std::move(dense));
+        _sparse.~vector();
+        new (&_sparse) std::pmr::vector<Entity>(std::move(sparse));
+    }
+
+    /**
+     * @brief Gets the memory resource backing the arrays
+     * @return The memory resource
+     */
+    std::pmr::memory_resource *getMemoryResource() const {
+        return _dense.get_allocator().resource();
+    }
+
+    /**
+     * @brief Adds an entity
+     * @param entity The entity
+     * @return True if the entity was added, false if it was already present
+     */
+    bool insert(Entity entity) {
+        if (contains(entity)) {
+            return false;
+        }
+        Entity index = entityIndex(entity);
+        if (index >= _sparse.size()) {
+            _sparse.resize(static_cast<std::size_t>(index) + 1, npos);
+        }
+        _sparse[index] = static_cast<Entity>(_dense.size());
+        _dense.push_back(entity);
+        return true;
+    }
+
+    /**
+     * @brief Removes an entity, moving the last entity into its position
+     * @param entity The entity
+     * @return True if the entity was removed, false if it was not present
+     */
+    bool erase(Entity entity) {
+        if (!contains(entity)) {
+            return false;
+        }
+        Entity index = _sparse[entityIndex(entity)];
+        Entity moved = _dense.back();
+
+        _dense[index] = moved;
+        _sparse[entityIndex(moved)] = index;
+        _dense.pop_back();
+        _sparse[entityIndex(entity)] = npos;
+        return true;
+    }
+
+    /**
+     * @brief Checks if an entity is part of the set
+     * @param entity The entity
+     * @return True if present
+     */
+    bool contains(Entity entity) const {
+        Entity index = entityIndex(entity);
+        return index < _sparse.size() && _sparse[index] != npos && _dense[_sparse[index]] == entity;
+    }
+
+    /**
+     * @brief Gets the packed position of an entity
+     * @param entity An entity part of the set
+     * @return Index into the packed array
+     */
+    std::size_t indexOf(Entity entity) const {
+        return _sparse[entityIndex(entity)];
+    }
+
+    /**
+     * @brief Exchanges the packed positions of two entities
+     * @param a Packed index, below size()
+     * @param b Packed index, below size()
+     */
+    void swapPositions(std::size_t a, std::size_t b) {
+        Entity first = _dense[a];
+        Entity second = _dense[b];
+
+        _dense[a] = second;
+        _dense[b] = first;
+        _sparse[entityIndex(second)] = static_cast<Entity>(a);
+        _sparse[entityIndex(first)] = static_cast<Entity>(b);
+    }
+
+    /**
+     * @brief Removes every entity
+     */
+    void clear() {
+        for (Entity entity : _dense) {
+            _sparse[entityIndex(entity)] = npos;
+        }
+        _dense.clear();
+    }
+
+    /**
+     * @brief Reserves room in the packed array
+     * @param capacity Number of entities to reserve
+     */
+    void reserve(std::size_t capacity) {
+        _dense.reserve(capacity);
+    }
+
+    std::size_t size() const { return _dense.size(); }
+    bool empty() const { return _dense.empty(); }
+
+    const Entity *data() const { return _dense.data(); }
+    const Entity *begin() const { return _dense.data(); }
+    const Entity *end() const { return _dense.data() + _dense.size(); }
+
+    Entity operator[](std::size_t index) const { return _dense[index]; }
+
+    /**
+     * @brief Gets a non-owning view over the packed entities
+     * @return Span valid until the set is modified
+     */
+    Span<const Entity> span() const {
+        return Span<const Entity>(_dense.data(), _dense.size());
+    }
+
+private:
+    /** Packed entities */
+    std::pmr::vector<Entity> _dense;
+
+    /** Entity slot index to packed index, npos when absent */
+    std::pmr::vector<Entity> _sparse;
+};
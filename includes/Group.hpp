@@ -0,0 +1,243 @@
+/**
+ * @file Group.hpp
+ * @brief Owning groups: persistent queries keeping their storages sorted in lockstep
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "AComponentStorage.hpp"
+#include "ComponentStorage.hpp"
+#include "Span.hpp"
+#include "Types.hpp"
+
+/**
+ * @struct GroupData
+ * @brief Type-erased state of an owning group, maintained by the ComponentManager
+ *
+ * The members of the group occupy the packed slots [0, size) of every owned storage,
+ * in the same order, so slot i of each storage belongs to the same entity.
+ */
+struct GroupData {
+    /** Component types owned by the group */
+    Signature owned;
+
+    /** Storages of the owned types */
+    std::vector<AComponentStorage *> storages;
+
+    /** Number of members */
+    std::size_t size = 0;
+
+    /**
+     * @brief Checks whether an entity is a member
+     * @param entity The entity
+     * @return True if the entity sits in the member slots
+     */
+    bool contains(Entity entity) const {
+        AComponentStorage *storage = storages.front();
+        return storage->hasEntity(entity) && storage->indexOfEntity(entity) < size;
+    }
+
+    /**
+     * @brief Adds an entity if it owns every owned type and is not a member yet
+     * @param entity The entity
+     */
+    void tryJoin(Entity entity) {
+        for (AComponentStorage *storage : storages) {
+            if (!storage->hasEntity(entity)) {
+                return;
+            }
+        }
+        if (storages.front()->indexOfEntity(entity) < size) {
+            return;
+        }
+        for (AComponentStorage *storage : storages) {
+            storage->swapEntries(storage->indexOfEntity(entity), size);
+        }
+        ++size;
+    }
+
+    /**
+     * @brief Removes a member, before one of its owned components goes away
+     * @param entity The entity (ignored if not a member)
+     */
+    void leave(Entity entity) {
+        if (!contains(entity)) {
+            return;
+        }
+        --size;
+        for (AComponentStorage *storage : storages) {
+            storage->swapEntries(storage->indexOfEntity(entity), size);
+        }
+    }
+
+    /**
+     * @brief Recomputes the members from the content of the storages
+     */
+    void rebuild() {
+        size = 0;
+        AComponentStorage *smallest = storages.front();
+        for (AComponentStorage *storage : storages) {
+            if (storage->entityCount() < smallest->entityCount()) {
+                smallest = storage;
+            }
+        }
+        // Joining only swaps slots at or before the cursor, already visited
+        for (std::size_t i = 0; i < smallest->entityCount(); ++i) {
+            tryJoin(smallest->entityAt(i));
+        }
+    }
+};
+
+/**
+ * @class Group
+ * @brief Handle over an owning group of Ts..., see Coordinator::group()
+ * @tparam Ts Owned component types
+ *
+ * The group owns the storages of Ts...: their first size() packed slots hold the
+ * members, in the same order in every storage. Iterating is therefore a lockstep walk
+ * over plain arrays, with no sparse lookup and no matching test. The ComponentManager
+ * keeps the order up to date as components are added and removed.
+ *
+ * Members are visited from the back, so removing an owned component from (or
+ * destroying) the entity currently visited is safe. Any other structural change
+ * during iteration invalidates the iteration, not the handle.
+ */
+template <typename... Ts>
+class Group {
+    static_assert(sizeof...(Ts) > 0, "A group needs at least one component type");
+
+    using Storages = std::tuple<BasicComponentStorage<Ts> *...>;
+    using Indices = std::index_sequence_for<Ts...>;
+
+public:
+    /** Value yielded for every member */
+    using value_type = std::tuple<Entity, ComponentRef<Ts>...>;
+
+    /**
+     * @class Iterator
+     * @brief Forward iterator over the members of a group
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Group::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator(const Group *group, std::size_t index) : _group(group), _index(index) {}
+
+        value_type operator*() const {
+            return _group->get(_index - 1, Indices{});
+        }
+
+        Iterator &operator++() {
+            --_index;
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return _index == other._index; }
+        bool operator!=(const Iterator &other) const { return _index != other._index; }
+
+    private:
+        const Group *_group;
+
+        /** One past the slot of the current member (0 means end) */
+        std::size_t _index;
+    };
+
+    /**
+     * @brief Builds a handle over a group
+     * @param storages Storages of the owned types
+     * @param data State of the group, owned by the ComponentManager
+     */
+    Group(Storages storages, const GroupData *data) : _storages(storages), _data(data) {}
+
+    Iterator begin() const { return Iterator(this, size()); }
+    Iterator end() const { return Iterator(this, 0); }
+
+    /**
+     * @brief Gets the number of members
+     * @return Number of entities owning every one of Ts...
+     */
+    std::size_t size() const {
+        return _data->size;
+    }
+
+    /**
+     * @brief Checks whether the group is empty
+     * @return True if no entity owns every one of Ts...
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Checks whether an entity is a member
+     * @param entity The entity
+     * @return True if the entity owns every one of Ts...
+     */
+    bool contains(Entity entity) const {
+        return _data->contains(entity);
+    }
+
+    /**
+     * @brief Gets the members
+     * @return Span over the packed entities of the first owned storage, valid until
+     *         the next structural change
+     */
+    Span<const Entity> entities() const {
+        return Span<const Entity>(std::get<0>(_storages)->entities(), size());
+    }
+
+    /**
+     * @brief Calls a function for every member
+     * @param fn Callable taking (Entity, Ts&...), with SoARef<T> for SoA components
+     */
+    template <typename Fn>
+    void each(Fn &&fn) const {
+        const Entity *entities = std::get<0>(_storages)->entities();
+        for (std::size_t i = size(); i > 0; --i) {
+            eachAt(fn, entities[i - 1], i - 1, Indices{});
+        }
+    }
+
+    /**
+     * @brief Gets the packed array of an owned type, members first
+     * @tparam T An owned, non-SoA component type
+     * @return Pointer to the component of entities()[0], contiguous over size() elements
+     */
+    template <typename T>
+    T *data() const {
+        return std::get<BasicComponentStorage<T> *>(_storages)->data();
+    }
+
+    /**
+     * @brief Gets the field columns of an owned SoA type, restricted to the members
+     * @tparam T An owned component type declaring a SoALayout
+     * @return One span per field, parallel to entities()
+     */
+    template <typename T>
+    SoASpan<T> columns() const {
+        SoASpan<T> all = std::get<BasicComponentStorage<T> *>(_storages)->columns();
+        return SoASpan<T>(entities(), all.pointers());
+    }
+
+private:
+    Storages _storages;
+    const GroupData *_data;
+
+    template <std::size_t... Is>
+    value_type get(std::size_t index, std::index_sequence<Is...>) const {
+        return value_type(std::get<0>(_storages)->entities()[index], std::get<Is>(_storages)->at(index)...);
+    }
+
+    template <typename Fn, std::size_t... Is>
+    void eachAt(Fn &fn, Entity entity, std::size_t index, std::index_sequence<Is...>) const {
+        fn(entity, std::get<Is>(_storages)->at(index)...);
+    }
+};
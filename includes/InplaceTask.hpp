@@ -0,0 +1,120 @@
+/**
+ * @file InplaceTask.hpp
+ * @brief Move-only callable with small-buffer storage, used by the thread pool and command buffer
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class InplaceTask
+ * @brief Move-only void() callable stored in a fixed-size inline buffer
+ *
+ * Callables of at most INLINE_SIZE bytes (a few captured pointers, such as the tasks
+ * submitted by runFrame() and parallelFor()) are stored without allocating; larger
+ * or throwing-move callables fall back to one heap allocation.
+ */
+class InplaceTask {
+public:
+    /** Size of the inline buffer, in bytes */
+    static constexpr std::size_t INLINE_SIZE = 48;
+
+    InplaceTask() = default;
+
+    /**
+     * @brief Stores a callable
+     * @param fn Callable taking no argument
+     */
+    template <typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, InplaceTask>>>
+    InplaceTask(Fn &&fn) {
+        using Stored = std::decay_t<Fn>;
+        if constexpr (fitsInline<Stored>()) {
+            new (_storage) Stored(std::forward<Fn>(fn));
+            _ops = &INLINE_OPS<Stored>;
+        } else {
+            new (_storage) Stored *(new Stored(std::forward<Fn>(fn)));
+            _ops = &HEAP_OPS<Stored>;
+        }
+    }
+
+    InplaceTask(InplaceTask &&other) noexcept {
+        moveFrom(other);
+    }
+
+    InplaceTask &operator=(InplaceTask &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceTask(const InplaceTask &) = delete;
+    InplaceTask &operator=(const InplaceTask &) = delete;
+
+    ~InplaceTask() {
+        reset();
+    }
+
+    /**
+     * @brief Checks whether a callable is stored
+     */
+    explicit operator bool() const { return _ops != nullptr; }
+
+    /**
+     * @brief Runs the stored callable
+     */
+    void operator()() {
+        _ops->invoke(_storage);
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *);
+        void (*move)(void *destination, void *source) noexcept;
+        void (*destroy)(void *) noexcept;
+    };
+
+    template <typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static constexpr Ops INLINE_OPS{
+        [](void *storage) { (*static_cast<Fn *>(storage))(); },
+        [](void *destination, void *source) noexcept {
+            new (destination) Fn(std::move(*static_cast<Fn *>(source)));
+            static_cast<Fn *>(source)->~Fn();
+        },
+        [](void *storage) noexcept { static_cast<Fn *>(storage)->~Fn(); },
+    };
+
+    template <typename Fn>
+    static constexpr Ops HEAP_OPS{
+        [](void *storage) { (**static_cast<Fn **>(storage))(); },
+        [](void *destination, void *source) noexcept { new (destination) Fn *(*static_cast<Fn **>(source)); },
+        [](void *storage) noexcept { delete *static_cast<Fn **>(storage); },
+    };
+
+    alignas(std::max_align_t) unsigned char _storage[INLINE_SIZE];
+    const Ops *_ops = nullptr;
+
+    void moveFrom(InplaceTask &other) noexcept {
+        if (other._ops) {
+            other._ops->move(_storage, other._storage);
+            _ops = other._ops;
+            other._ops = nullptr;
+        }
+    }
+
+    void reset() noexcept {
+        if (_ops) {
+            _ops->destroy(_storage);
+            _ops = nullptr;
+        }
+    }
+};
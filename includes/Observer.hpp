@@ -0,0 +1,191 @@
+/**
+ * @file Observer.hpp
+ * @brief Component lifecycle observers (component added / removed)
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Types.hpp"
+
+/**
+ * @typedef ObserverID
+ * @brief Handle returned when an observer is registered, used to unregister it
+ */
+using ObserverID = std::uint32_t;
+
+/**
+ * @enum ComponentEvent
+ * @brief Lifecycle event of a component
+ */
+enum class ComponentEvent : std::uint8_t {
+    Added,
+    Removed
+};
+
+/**
+ * @class ObserverRegistry
+ * @brief Stores lifecycle callbacks per component type and queues the matching events
+ *
+ * Structural changes record events with record() while the
+ * coordinator lock is held; the coordinator takes the queue with takePending()
+ * before releasing the lock and calls dispatch() once it is released, so callbacks
+ * may call back into the coordinator. A flush therefore delivers the events of all
+ * its commands in one batch, in application order.
+ *
+ * Recording is a bit test when no observer watches the type, so unobserved types
+ * cost nothing. Observers are added and removed at initialization or between
+ * frames, never from a callback or concurrently with structural changes.
+ */
+class ObserverRegistry {
+public:
+    /**
+     * @struct Event
+     * @brief A recorded lifecycle event
+     */
+    struct Event {
+        Entity entity;
+        ComponentTypeID type;
+        ComponentEvent kind;
+    };
+
+    /** Queue of recorded events */
+    using Events = std::vector<Event>;
+
+    /**
+     * @brief Registers a callback
+     * @param type Observed component type
+     * @param kind Observed event
+     * @param callback Called with the entity of every matching event
+     * @return Handle for disconnect()
+     */
+    ObserverID connect(ComponentTypeID type, ComponentEvent kind, std::function<void(Entity)> callback) {
+        ObserverID id = nextID++;
+        callbacks(kind)[type].push_back({id, std::move(callback)});
+        watched(kind).set(type);
+        return id;
+    }
+
+    /**
+     * @brief Unregisters a callback
+     * @param id Handle returned by connect() (unknown handles are ignored)
+     */
+    void disconnect(ObserverID id) {
+        for (ComponentEvent kind : {ComponentEvent::Added, ComponentEvent::Removed}) {
+            auto &lists = callbacks(kind);
+            for (std::size_t type = 0; type < lists.size(); ++type) {
+                auto &list = lists[type];
+                for (std::size_t i = 0; i < list.size(); ++i) {
+                    if (list[i].id == id) {
+                        list.erase(list.begin() + static_cast<std::ptrdiff_t>(i));
+                        watched(kind).set(type, !list.empty());
+                        return;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Removes every callback and pending event
+     */
+    void clear() {
+        for (auto &list : addedCallbacks) {
+            list.clear();
+        }
+        for (auto &list : removedCallbacks) {
+            list.clear();
+        }
+        watchedAdded.reset();
+        watchedRemoved.reset();
+        pending.clear();
+    }
+
+    /**
+     * @brief Gets the component types watched for an event
+     * @param kind Event kind
+     * @return Bit set for every type with at least one callback
+     */
+    const Signature &watchedTypes(ComponentEvent kind) const {
+        return kind == ComponentEvent::Added ? watchedAdded : watchedRemoved;
+    }
+
+    /**
+     * @brief Records an event if its component type is observed
+     * @param entity Entity concerned
+     * @param type Component type
+     * @param kind Event kind
+     */
+    void record(Entity entity, ComponentTypeID type, ComponentEvent kind) {
+        if (watchedTypes(kind).test(type)) {
+            pending.push_back({entity, type, kind});
+        }
+    }
+
+    /**
+     * @brief Records an event for every observed type of a signature
+     * @param entity Entity concerned
+     * @param signature Component types concerned, e.g. the signature of a destroyed entity
+     * @param kind Event kind
+     */
+    void record(Entity entity, const Signature &signature, ComponentEvent kind) {
+        Signature observed = signature & watchedTypes(kind);
+        if (observed.none()) {
+            return;
+        }
+        forEachSetBit(observed, [&](ComponentTypeID type) { pending.push_back({entity, type, kind}); });
+    }
+
+    /**
+     * @brief Takes the recorded events
+     * @return Events recorded since the last call, in recording order
+     */
+    Events takePending() {
+        Events events;
+        events.swap(pending);
+        return events;
+    }
+
+    /**
+     * @brief Calls the callbacks of every event
+     * @param events Events returned by takePending()
+     */
+    void dispatch(const Events &events) const {
+        for (const Event &event : events) {
+            for (const Entry &entry : callbacks(event.kind)[event.type]) {
+                entry.callback(event.entity);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        ObserverID id;
+        std::function<void(Entity)> callback;
+    };
+
+    using Lists = std::array<std::vector<Entry>, MAX_COMPONENTS>;
+
+    Lists addedCallbacks{};
+    Lists removedCallbacks{};
+    Signature watchedAdded{};
+    Signature watchedRemoved{};
+    Events pending{};
+    ObserverID nextID = 0;
+
+    Lists &callbacks(ComponentEvent kind) {
+        return kind == ComponentEvent::Added ? addedCallbacks : removedCallbacks;
+    }
+
+    const Lists &callbacks(ComponentEvent kind) const {
+        return kind == ComponentEvent::Added ? addedCallbacks : removedCallbacks;
+    }
+
+    Signature &watched(ComponentEvent kind) {
+        return kind == ComponentEvent::Added ? watchedAdded : watchedRemoved;
+    }
+};
@@ -0,0 +1,290 @@
+/**
+ * @file Profiler.hpp
+ * @brief Optional per-system profiling and Chrome trace output
+ *
+ * Compiled in with `-DECS_ENABLE_PROFILING=1` (CMake option ECS_ENABLE_PROFILING).
+ * Without it the hooks in System, SystemManager and Coordinator compile to plain
+ * calls and the stats APIs return empty results.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#ifndef ECS_ENABLE_PROFILING
+#define ECS_ENABLE_PROFILING 0
+#endif
+
+/**
+ * @struct SystemCounters
+ * @brief Raw profiling counters of one system
+ *
+ * Written by the thread running the system; read them between frames.
+ */
+struct SystemCounters {
+    /** Number of update() runs */
+    std::uint64_t invocations = 0;
+
+    /** Sum of the entity counts of every run */
+    std::uint64_t entitiesProcessed = 0;
+
+    /** Entity count of the last run */
+    std::size_t lastEntityCount = 0;
+
+    /** Wall time of every run, in nanoseconds */
+    std::uint64_t totalNs = 0;
+
+    /** Wall time of the last run, in nanoseconds */
+    std::uint64_t lastNs = 0;
+
+    /** Longest run, in nanoseconds */
+    std::uint64_t maxNs = 0;
+
+    /** Time spent waiting on the ECS mutex from inside the system, in nanoseconds */
+    std::atomic<std::uint64_t> lockWaitNs{0};
+
+    /** Resets every counter */
+    void reset() {
+        invocations = 0;
+        entitiesProcessed = 0;
+        lastEntityCount = 0;
+        totalNs = 0;
+        lastNs = 0;
+        maxNs = 0;
+        lockWaitNs.store(0, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @struct SystemStats
+ * @brief Snapshot of the profiling counters of one system, in milliseconds
+ */
+struct SystemStats {
+    std::string name;
+    std::uint64_t invocations = 0;
+    std::uint64_t entitiesProcessed = 0;
+    std::size_t lastEntityCount = 0;
+    double totalMs = 0.0;
+    double lastMs = 0.0;
+    double maxMs = 0.0;
+    double lockWaitMs = 0.0;
+};
+
+/**
+ * @class Profiler
+ * @brief Process-wide sink for system timings, ECS mutex waits and trace events
+ *
+ * Trace events are only recorded between setTracing(true) and setTracing(false) and
+ * are written in the Chrome trace event format (chrome://tracing, Perfetto, or
+ * Tracy through its chrome importer).
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Whether profiling is compiled in */
+    static constexpr bool enabled = ECS_ENABLE_PROFILING != 0;
+
+    /**
+     * @brief Gets the process-wide profiler
+     * @return Reference to the profiler
+     */
+    static Profiler &global() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @brief Runs one invocation of a system and records it
+     * @param counters Counters of the system
+     * @param entityCount Number of entities the system processes
+     * @param name Name of the system, used for trace events
+     * @param fn Callable running the system
+     *
+     * Mutex waits happening inside fn on the calling thread are charged to counters.
+     */
+    template <typename Fn>
+    void measure(SystemCounters &counters, std::size_t entityCount, const char *name, Fn &&fn) {
+        if constexpr (!enabled) {
+            (void)counters;
+            (void)entityCount;
+            (void)name;
+            fn();
+        } else {
+            SystemCounters *previous = current();
+            current() = &counters;
+            Clock::time_point begin = Clock::now();
+            try {
+                fn();
+            } catch (...) {
+                current() = previous;
+                throw;
+            }
+            Clock::time_point end = Clock::now();
+            current() = previous;
+
+            auto elapsed = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+            ++counters.invocations;
+            counters.entitiesProcessed += entityCount;
+            counters.lastEntityCount = entityCount;
+            counters.totalNs += elapsed;
+            counters.lastNs = elapsed;
+            if (elapsed > counters.maxNs) {
+                counters.maxNs = elapsed;
+            }
+            if (_tracing.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(_traceMutex);
+                _events.push_back({name, microseconds(begin), elapsed / 1000, threadIndex()});
+            }
+        }
+    }
+
+    /**
+     * @brief Records time spent acquiring the ECS mutex
+     * @param wait Time between the lock request and its acquisition
+     */
+    void addLockWait(Clock::duration wait) {
+        auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+        _lockWaitNs.fetch_add(ns, std::memory_order_relaxed);
+        _lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        if (SystemCounters *counters = current()) {
+            counters->lockWaitNs.fetch_add(ns, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Gets the total time spent acquiring the ECS mutex
+     * @return Wait time in milliseconds, all threads together
+     */
+    double getLockWaitMs() const {
+        return static_cast<double>(_lockWaitNs.load(std::memory_order_relaxed)) / 1e6;
+    }
+
+    /**
+     * @brief Gets the number of ECS mutex acquisitions measured
+     * @return Acquisition count
+     */
+    std::uint64_t getLockAcquisitions() const {
+        return _lockAcquisitions.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Starts or stops recording trace events
+     * @param tracing True to record one event per system run
+     */
+    void setTracing(bool tracing) {
+        _tracing.store(tracing, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Resets the mutex counters and drops the recorded trace events
+     */
+    void reset() {
+        _lockWaitNs.store(0, std::memory_order_relaxed);
+        _lockAcquisitions.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(_traceMutex);
+        _events.clear();
+    }
+
+    /**
+     * @brief Writes the recorded events as a Chrome trace JSON document
+     * @param stream Destination
+     */
+    void writeChromeTrace(std::ostream &stream) const {
+        std::lock_guard<std::mutex> lock(_traceMutex);
+        stream << "{\"traceEvents\":[";
+        for (std::size_t i = 0; i < _events.size(); ++i) {
+            const TraceEvent &event = _events[i];
+            stream << (i ? "," : "") << "\n{\"name\":\"";
+            for (char c : event.name) {
+                if (c == '"' || c == '\\') {
+                    stream << '\\';
+                }
+                stream << c;
+            }
+            stream << "\",\"cat\":\"system\",\"ph\":\"X\",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs
+                   << ",\"pid\":0,\"tid\":" << event.thread << "}";
+        }
+        stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    /**
+     * @brief Gets a readable name for a type
+     * @param type Type to name
+     * @return The demangled name where the compiler supports it, the raw name otherwise
+     */
+    static std::string typeName(const std::type_info &type) {
+#if defined(__GNUG__)
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+        if (status == 0 && demangled) {
+            std::string name(demangled);
+            std::free(demangled);
+            return name;
+        }
+#endif
+        return type.name();
+    }
+
+    /**
+     * @brief Converts raw counters to milliseconds
+     * @param name Name of the system
+     * @param counters Counters of the system
+     * @return The stats snapshot
+     */
+    static SystemStats toStats(const std::string &name, const SystemCounters &counters) {
+        SystemStats stats;
+        stats.name = name;
+        stats.invocations = counters.invocations;
+        stats.entitiesProcessed = counters.entitiesProcessed;
+        stats.lastEntityCount = counters.lastEntityCount;
+        stats.totalMs = static_cast<double>(counters.totalNs) / 1e6;
+        stats.lastMs = static_cast<double>(counters.lastNs) / 1e6;
+        stats.maxMs = static_cast<double>(counters.maxNs) / 1e6;
+        stats.lockWaitMs = static_cast<double>(counters.lockWaitNs.load(std::memory_order_relaxed)) / 1e6;
+        return stats;
+    }
+
+private:
+    struct TraceEvent {
+        std::string name;
+        std::uint64_t startUs;
+        std::uint64_t durationUs;
+        std::uint32_t thread;
+    };
+
+    Clock::time_point _origin = Clock::now();
+    std::atomic_bool _tracing{false};
+    std::atomic<std::uint64_t> _lockWaitNs{0};
+    std::atomic<std::uint64_t> _lockAcquisitions{0};
+    mutable std::mutex _traceMutex;
+    std::vector<TraceEvent> _events;
+
+    /** Counters of the system running on the calling thread, if any */
+    static SystemCounters *&current() {
+        thread_local SystemCounters *counters = nullptr;
+        return counters;
+    }
+
+    /** Small stable identifier of the calling thread, used as trace tid */
+    static std::uint32_t threadIndex() {
+        static std::atomic<std::uint32_t> next{0};
+        thread_local std::uint32_t index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    std::uint64_t microseconds(Clock::time_point time) const {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(time - _origin).count());
+    }
+};
@@ -0,0 +1,207 @@
+/**
+ * @file Shared.hpp
+ * @brief Shared components (one value referenced by many entities) and world singletons
+ */
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @class Shared
+ * @brief Component handle to an immutable value shared by many entities
+ * @tparam T Type of the shared value, e.g. a material or a configuration
+ *
+ * Register and add Shared<T> like any other component: each entity then stores a
+ * pointer-sized, reference-counted handle instead of its own copy of T, so thousands
+ * of entities using the same material keep a single one in memory. The value is
+ * const, so it can be read from any system without synchronization; to change it for
+ * some entities, give them a handle to another value.
+ *
+ * Handles are not trivially copyable, so Shared<T> components are copied by cloneWorld()
+ * (sharing the value across worlds) but left out of snapshots: saving a world that uses
+ * them still works, and the loaded entities simply come back without their Shared<T>
+ * components (set them again after loading).
+ */
+template <typename T>
+class Shared {
+public:
+    /** Null handle */
+    Shared() = default;
+
+    /**
+     * @brief Wraps an existing value
+     * @param value The shared value
+     */
+    explicit Shared(std::shared_ptr<const T> value) : _value(std::move(value)) {}
+
+    /**
+     * @brief Creates a new shared value
+     * @param args Arguments forwarded to the constructor of T
+     * @return Handle to the new value, to copy into the components of many entities
+     */
+    template <typename... Args>
+    static Shared make(Args &&...args) {
+        if constexpr (std::is_constructible_v<T, Args &&...>) {
+            return Shared(std::make_shared<const T>(std::forward<Args>(args)...));
+        } else {
+            return Shared(std::make_shared<const T>(T{std::forward<Args>(args)...}));
+        }
+    }
+
+    const T &operator*() const { return *_value; }
+    const T *operator->() const { return _value.get(); }
+
+    /**
+     * @brief Gets the shared value
+     * @return Pointer to the value, nullptr for a null handle
+     */
+    const T *get() const { return _value.get(); }
+
+    explicit operator bool() const { return _value != nullptr; }
+
+    /**
+     * @brief Gets the number of handles to the value
+     * @return Number of entities (and other holders) sharing the value, 0 for a null handle
+     */
+    long useCount() const { return _value.use_count(); }
+
+    /** Handles are equal when they share the same value (not merely equal values) */
+    bool operator==(const Shared &other) const { return _value == other._value; }
+    bool operator!=(const Shared &other) const { return _value != other._value; }
+
+private:
+    std::shared_ptr<const T> _value;
+};
+
+/**
+ * @var isShared
+ * @brief True if T is a Shared<U> handle, a component type left out of snapshots
+ */
+template <typename T>
+inline constexpr bool isShared = false;
+
+template <typename T>
+inline constexpr bool isShared<Shared<T>> = true;
+
+/**
+ * @class SingletonRegistry
+ * @brief At most one value per type, owned by a world rather than by an entity
+ *
+ * Holds world-wide data (input state, physics settings, the active camera...) that
+ * would otherwise be a component on a dummy entity. Values are looked up by type.
+ */
+class SingletonRegistry {
+public:
+    /**
+     * @brief Creates or replaces the singleton of a type
+     * @tparam T Singleton type
+     * @param args Arguments forwarded to the constructor of T
+     * @return Reference to the new value
+     */
+    template <typename T, typename... Args>
+    T &set(Args &&...args) {
+        Entry entry;
+        if constexpr (std::is_constructible_v<T, Args &&...>) {
+            entry.value = std::make_shared<T>(std::forward<Args>(args)...);
+        } else {
+            entry.value = std::make_shared<T>(T{std::forward<Args>(args)...});
+        }
+        if constexpr (std::is_copy_constructible_v<T>) {
+            entry.clone = [](const void *value) -> std::shared_ptr<void> {
+                return std::make_shared<T>(*static_cast<const T *>(value));
+            };
+        }
+        T &value = *static_cast<T *>(entry.value.get());
+        _entries[std::type_index(typeid(T))] = std::move(entry);
+        return value;
+    }
+
+    /**
+     * @brief Gets the singleton of a type
+     * @tparam T Singleton type
+     * @return Reference to the value
+     * @throws std::out_of_range if no singleton of this type is set
+     */
+    template <typename T>
+    T &get() {
+        T *value = tryGet<T>();
+        if (!value) {
+            throw std::out_of_range(std::string("SingletonRegistry::get: no singleton of type ") + typeid(T).name());
+        }
+        return *value;
+    }
+
+    /**
+     * @brief Gets the singleton of a type, if set
+     * @tparam T Singleton type
+     * @return Pointer to the value, or nullptr
+     */
+    template <typename T>
+    T *tryGet() {
+        auto it = _entries.find(std::type_index(typeid(T)));
+        return it == _entries.end() ? nullptr : static_cast<T *>(it->second.value.get());
+    }
+
+    /**
+     * @brief Checks whether the singleton of a type is set
+     * @tparam T Singleton type
+     * @return True if set
+     */
+    template <typename T>
+    bool has() const {
+        return _entries.count(std::type_index(typeid(T))) != 0;
+    }
+
+    /**
+     * @brief Destroys the singleton of a type
+     * @tparam T Singleton type (ignored if not set)
+     */
+    template <typename T>
+    void remove() {
+        _entries.erase(std::type_index(typeid(T)));
+    }
+
+    /**
+     * @brief Destroys every singleton
+     */
+    void clear() {
+        _entries.clear();
+    }
+
+    /**
+     * @brief Replaces the content with deep copies of the singletons of another registry
+     * @param source The registry to copy
+     * @throws std::logic_error if a singleton type is not copyable (nothing is replaced)
+     */
+    void copyFrom(const SingletonRegistry &source) {
+        std::unordered_map<std::type_index, Entry> copies;
+        for (const auto &[type, entry] : source._entries) {
+            if (!entry.clone) {
+                throw std::logic_error(std::string("Singleton type is not copyable: ") + type.name());
+            }
+            copies.emplace(type, Entry{entry.clone(entry.value.get()), entry.clone});
+        }
+        _entries = std::move(copies);
+    }
+
+private:
+    /**
+     * @struct Entry
+     * @brief A type-erased singleton and the way to copy it
+     */
+    struct Entry {
+        std::shared_ptr<void> value;
+
+        /** Deep copy of a value, null for non-copyable types */
+        std::shared_ptr<void> (*clone)(const void *value) = nullptr;
+    };
+
+    std::unordered_map<std::type_index, Entry> _entries;
+};
@@ -0,0 +1,179 @@
+/**
+ * @file Snapshot.hpp
+ * @brief Binary snapshot stream helpers used to save and load a world
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Types.hpp"
+
+/** Magic number opening every snapshot ("ECSS" in little endian) */
+inline constexpr std::uint32_t SNAPSHOT_MAGIC = 0x53534345u;
+
+/** Version of the snapshot layout, bumped on every incompatible change */
+inline constexpr std::uint32_t SNAPSHOT_VERSION = 3;
+
+/**
+ * @class SnapshotWriter
+ * @brief Writes trivially copyable values and arrays to a binary stream
+ *
+ * Values are written in native byte order: a snapshot is meant to be loaded by the
+ * same build on the same platform (crash recovery, replays), not exchanged.
+ */
+class SnapshotWriter {
+public:
+    /**
+     * @brief Creates a writer
+     * @param stream Destination, opened in binary mode
+     */
+    explicit SnapshotWriter(std::ostream &stream) : _stream(stream) {}
+
+    /**
+     * @brief Writes a value
+     * @param value Trivially copyable value
+     * @throws std::runtime_error if the stream fails
+     */
+    template <typename T>
+    void write(const T &value) {
+        writeArray(&value, 1);
+    }
+
+    /**
+     * @brief Writes an array in one block
+     * @param data First element
+     * @param count Number of elements
+     * @throws std::runtime_error if the stream fails
+     */
+    template <typename T>
+    void writeArray(const T *data, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshots only hold trivially copyable data");
+        if (count == 0) {
+            return;
+        }
+        _stream.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        if (!_stream) {
+            throw std::runtime_error("Snapshot: write failed.");
+        }
+    }
+
+    /**
+     * @brief Writes a length-prefixed string
+     * @param value String to write
+     */
+    void writeString(const std::string &value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        writeArray(value.data(), value.size());
+    }
+
+private:
+    std::ostream &_stream;
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Reads values and arrays written by a SnapshotWriter
+ */
+class SnapshotReader {
+public:
+    /**
+     * @brief Creates a reader
+     * @param stream Source, opened in binary mode
+     */
+    explicit SnapshotReader(std::istream &stream) : _stream(stream) {}
+
+    /**
+     * @brief Reads a value
+     * @return The value
+     * @throws std::runtime_error if the stream ends early
+     */
+    template <typename T>
+    T read() {
+        T value;
+        readArray(&value, 1);
+        return value;
+    }
+
+    /**
+     * @brief Reads an array in one block
+     * @param data Destination of count elements
+     * @param count Number of elements
+     * @throws std::runtime_error if the stream ends early
+     */
+    template <typename T>
+    void readArray(T *data, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshots only hold trivially copyable data");
+        if (count == 0) {
+            return;
+        }
+        _stream.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        if (!_stream) {
+            throw std::runtime_error("Snapshot: unexpected end of data.");
+        }
+    }
+
+    /**
+     * @brief Reads a length-prefixed string
+     * @return The string
+     * @throws std::runtime_error if the stream ends before the announced length
+     *
+     * The string grows block by block as data is actually read, so a corrupt length
+     * cannot make it allocate more than the stream holds.
+     */
+    std::string readString() {
+        std::size_t length = read<std::uint32_t>();
+        requireAvailable(length);
+        std::string value;
+        while (value.size() < length) {
+            std::size_t size = value.size();
+            value.resize(size + std::min<std::size_t>(STRING_BLOCK, length - size));
+            readArray(value.data() + size, value.size() - size);
+        }
+        return value;
+    }
+
+    /**
+     * @brief Checks that the stream still holds some bytes, before allocating for them
+     * @param bytes Number of bytes about to be read
+     * @throws std::runtime_error if the stream is seekable and holds fewer bytes
+     *
+     * Streams that cannot seek are not checked; their reads still fail at the end.
+     */
+    void requireAvailable(std::size_t bytes) {
+        std::streampos position = _stream.tellg();
+        if (position == std::streampos(-1)) {
+            return;
+        }
+        _stream.seekg(0, std::ios::end);
+        std::streampos end = _stream.tellg();
+        _stream.seekg(position);
+        if (end != std::streampos(-1) && static_cast<std::size_t>(end - position) < bytes) {
+            throw std::runtime_error("Snapshot: unexpected end of data.");
+        }
+    }
+
+    /**
+     * @brief Reads a value and checks it against the expected one
+     * @param expected Expected value
+     * @param what Name of the value, used in the error message
+     * @throws std::runtime_error on mismatch
+     */
+    template <typename T>
+    void expect(const T &expected, const char *what) {
+        if (read<T>() != expected) {
+            throw std::runtime_error(std::string("Snapshot: incompatible ") + what + ".");
+        }
+    }
+
+private:
+    /** Largest block a string is grown by while it is read */
+    static constexpr std::size_t STRING_BLOCK = 4096;
+
+    std::istream &_stream;
+};
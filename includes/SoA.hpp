@@ -0,0 +1,605 @@
+/**
+ * @file SoA.hpp
+ * @brief Opt-in structure-of-arrays layout for plain arithmetic components
+ *
+ * A component opts in by specializing SoALayout with the list of its fields:
+ * @code
+ * struct Position { float x, y, z; };
+ * template <> struct SoALayout<Position> : SoAFields<&Position::x, &Position::y, &Position::z> {};
+ * @endcode
+ * Its storage then keeps every field in its own aligned column instead of packing
+ * whole Position objects. Since no Position object exists in memory, the APIs that
+ * return a component reference return a SoARef<T> proxy (see ComponentRef), and
+ * columns() hands out one Span per field for vectorized loops.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Snapshot.hpp"
+#include "Span.hpp"
+#include "Types.hpp"
+
+#ifndef ECS_SOA_ALIGNMENT
+/**
+ * @def ECS_SOA_ALIGNMENT
+ * @brief Alignment in bytes of every SoA column (override with -DECS_SOA_ALIGNMENT=N)
+ */
+#define ECS_SOA_ALIGNMENT 64
+#endif
+
+/**
+ * @struct SoALayout
+ * @brief Trait selecting the SoA layout for a component type; specialize it from SoAFields
+ * @tparam T Component type
+ */
+template <typename T>
+class SoAPtr;
+
+template <typename T>
+struct SoALayout {
+    static constexpr bool enabled = false;
+};
+
+/**
+ * @struct MemberTraits
+ * @brief Splits a pointer to data member into its class and field types
+ */
+template <typename M>
+struct MemberTraits;
+
+template <typename C, typename F>
+struct MemberTraits<F C::*> {
+    using Class = C;
+    using Field = F;
+};
+
+/**
+ * @struct SoAFields
+ * @brief Base of a SoALayout specialization, listing the fields stored as columns
+ * @tparam Members Pointers to the data members of the component, every member of it
+ *
+ * The component must be trivially copyable and default-constructible, and every
+ * field trivially copyable (typically float, double or integers).
+ */
+template <auto... Members>
+struct SoAFields {
+    static_assert(sizeof...(Members) > 0, "A SoA layout needs at least one field");
+
+    static constexpr bool enabled = true;
+
+    /** Number of columns */
+    static constexpr std::size_t count = sizeof...(Members);
+
+    /** The member pointers, in column order */
+    static constexpr std::tuple<decltype(Members)...> members{Members...};
+
+    /** Field types, in column order */
+    using Fields = std::tuple<typename MemberTraits<decltype(Members)>::Field...>;
+};
+
+/**
+ * @var isSoA
+ * @brief True if T opted into the SoA layout
+ */
+template <typename T>
+inline constexpr bool isSoA = SoALayout<std::remove_cv_t<T>>::enabled;
+
+/**
+ * @typedef SoAField
+ * @brief Type of the I-th column of a SoA component
+ */
+template <typename T, std::size_t I>
+using SoAField = std::tuple_element_t<I, typename SoALayout<T>::Fields>;
+
+/**
+ * @brief Finds the column of a member pointer
+ * @tparam T SoA component type
+ * @tparam Member Pointer to one of the declared fields
+ * @return Column index of the member
+ */
+template <typename T, auto Member, std::size_t I = 0>
+constexpr std::size_t soaIndexOf() {
+    if constexpr (I >= SoALayout<T>::count) {
+        static_assert(I < SoALayout<T>::count, "Member is not a field of the SoA layout");
+        return I;
+    } else {
+        constexpr auto candidate = std::get<I>(SoALayout<T>::members);
+        if constexpr (std::is_same_v<std::remove_const_t<decltype(candidate)>, decltype(Member)>) {
+            if constexpr (candidate == Member) {
+                return I;
+            } else {
+                return soaIndexOf<T, Member, I + 1>();
+            }
+        } else {
+            return soaIndexOf<T, Member, I + 1>();
+        }
+    }
+}
+
+/**
+ * @class AlignedColumn
+ * @brief Growable array of a trivially copyable type, aligned to ECS_SOA_ALIGNMENT
+ * @tparam U Element type
+ *
+ * The capacity is always a whole number of alignment blocks and the slack is
+ * zero-filled, so a vector loop may round size() up to its lane count and touch the
+ * padding without reading outside the allocation.
+ */
+template <typename U>
+class AlignedColumn {
+    static_assert(std::is_trivially_copyable_v<U>, "SoA fields must be trivially copyable");
+
+public:
+    /** Number of elements per alignment block */
+    static constexpr std::size_t BLOCK = std::max<std::size_t>(1, ECS_SOA_ALIGNMENT / sizeof(U));
+
+    explicit AlignedColumn(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : _resource(resource) {}
+
+    AlignedColumn(const AlignedColumn &other) : _resource(std::pmr::get_default_resource()) {
+        reserve(other._size);
+        if (other._size > 0) {
+            std::memcpy(_data, other._data, other._size * sizeof(U));
+        }
+        _size = other._size;
+    }
+
+    AlignedColumn(AlignedColumn &&other) noexcept
+        : _resource(other._resource), _data(other._data), _size(other._size), _capacity(other._capacity) {
+        other._data = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+
+    AlignedColumn &operator=(const AlignedColumn &other) {
+        if (this != &other) {
+            resize(other._size);
+            if (other._size > 0) {
+                std::memcpy(_data, other._data, other._size * sizeof(U));
+            }
+        }
+        return *this;
+    }
+
+    AlignedColumn &operator=(AlignedColumn &&other) noexcept {
+        if (this != &other) {
+            release();
+            _resource = other._resource;
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+        }
+        return *this;
+    }
+
+    ~AlignedColumn() {
+        release();
+    }
+
+    U *data() { return _data; }
+    const U *data() const { return _data; }
+    std::size_t size() const { return _size; }
+    std::size_t capacity() const { return _capacity; }
+
+    U &operator[](std::size_t index) { return _data[index]; }
+    const U &operator[](std::size_t index) const { return _data[index]; }
+
+    /**
+     * @brief Appends an element; the capacity must already allow it (see reserve())
+     */
+    void pushUnchecked(const U &value) {
+        _data[_size++] = value;
+    }
+
+    void pop_back() {
+        --_size;
+    }
+
+    /**
+     * @brief Grows the capacity to at least count elements
+     * @param count Requested capacity
+     */
+    void reserve(std::size_t count) {
+        if (count <= _capacity) {
+            return;
+        }
+        std::size_t capacity = (count + BLOCK - 1) / BLOCK * BLOCK;
+        U *data = static_cast<U *>(_resource->allocate(capacity * sizeof(U), alignment()));
+        if (_size > 0) {
+            std::memcpy(data, _data, _size * sizeof(U));
+        }
+        std::memset(static_cast<void *>(data + _size), 0, (capacity - _size) * sizeof(U));
+        release();
+        _data = data;
+        _capacity = capacity;
+    }
+
+    /**
+     * @brief Resizes the column, new elements being zero-filled
+     * @param count New size
+     */
+    void resize(std::size_t count) {
+        reserve(count);
+        if (count > _size) {
+            std::memset(static_cast<void *>(_data + _size), 0, (count - _size) * sizeof(U));
+        }
+        _size = count;
+    }
+
+    void clear() {
+        _size = 0;
+    }
+
+private:
+    std::pmr::memory_resource *_resource;
+    U *_data = nullptr;
+    std::size_t _size = 0;
+    std::size_t _capacity = 0;
+
+    static constexpr std::size_t alignment() {
+        return std::max<std::size_t>(ECS_SOA_ALIGNMENT, alignof(U));
+    }
+
+    void release() {
+        if (_data) {
+            _resource->deallocate(_data, _capacity * sizeof(U), alignment());
+            _data = nullptr;
+            _capacity = 0;
+        }
+    }
+};
+
+/**
+ * @class SoARef
+ * @brief Reference proxy to one SoA component, made of one pointer per field
+ * @tparam T SoA component type
+ *
+ * Behaves like vector<bool>::reference: copying a SoARef copies the pointers, while
+ * assigning to one writes the fields. Read the whole component with load() (or the
+ * conversion to T), write it with store() (or assignment from a T), and access a
+ * single field with field<&T::x>() or get<I>().
+ */
+template <typename T>
+class SoARef {
+    using Layout = SoALayout<T>;
+    using Indices = std::make_index_sequence<Layout::count>;
+
+    template <typename Fields>
+    struct PointersOf;
+
+    template <typename... Fs>
+    struct PointersOf<std::tuple<Fs...>> {
+        using type = std::tuple<Fs *...>;
+    };
+
+public:
+    /** One pointer per field */
+    using Pointers = typename PointersOf<typename Layout::Fields>::type;
+
+    explicit SoARef(Pointers pointers) : _pointers(pointers) {}
+
+    /**
+     * @brief Refers to the fields of a component object (e.g. in archetype storage)
+     * @param component The component
+     */
+    SoARef(T &component) : _pointers(pointersInto(component, Indices{})) {}
+
+    SoARef(const SoARef &) = default;
+
+    /**
+     * @brief Writes the fields of another component
+     */
+    SoARef &operator=(const SoARef &other) {
+        store(other.load());
+        return *this;
+    }
+
+    /**
+     * @brief Writes every field of a component value
+     */
+    SoARef &operator=(const T &value) {
+        store(value);
+        return *this;
+    }
+
+    /**
+     * @brief Accesses one field by member pointer, e.g. `ref.field<&Position::x>()`
+     */
+    template <auto Member>
+    auto &field() const {
+        return *std::get<soaIndexOf<T, Member>()>(_pointers);
+    }
+
+    /**
+     * @brief Accesses one field by column index
+     */
+    template <std::size_t I>
+    auto &get() const {
+        return *std::get<I>(_pointers);
+    }
+
+    /**
+     * @brief Gathers the fields into a component value
+     */
+    T load() const {
+        T value{};
+        loadInto(value, Indices{});
+        return value;
+    }
+
+    operator T() const {
+        return load();
+    }
+
+    /**
+     * @brief Scatters a component value into the fields
+     */
+    void store(const T &value) const {
+        storeFrom(value, Indices{});
+    }
+
+private:
+    friend class SoAPtr<T>;
+
+    Pointers _pointers;
+
+    template <std::size_t... Is>
+    static Pointers pointersInto(T &component, std::index_sequence<Is...>) {
+        return Pointers(&(component.*std::get<Is>(Layout::members))...);
+    }
+
+    template <std::size_t... Is>
+    void loadInto(T &value, std::index_sequence<Is...>) const {
+        ((value.*std::get<Is>(Layout::members) = *std::get<Is>(_pointers)), ...);
+    }
+
+    template <std::size_t... Is>
+    void storeFrom(const T &value, std::index_sequence<Is...>) const {
+        ((*std::get<Is>(_pointers) = value.*std::get<Is>(Layout::members)), ...);
+    }
+};
+
+/**
+ * @class SoAPtr
+ * @brief Nullable SoARef, the SoA counterpart of T*
+ * @tparam T SoA component type
+ */
+template <typename T>
+class SoAPtr {
+public:
+    SoAPtr() = default;
+    SoAPtr(std::nullptr_t) {}
+    explicit SoAPtr(SoARef<T> ref) : _ref(ref), _valid(true) {}
+    SoAPtr(const SoAPtr &) = default;
+
+    /** Rebinds the pointer (assigning the SoARef itself would write the fields) */
+    SoAPtr &operator=(const SoAPtr &other) {
+        _ref._pointers = other._ref._pointers;
+        _valid = other._valid;
+        return *this;
+    }
+
+    explicit operator bool() const { return _valid; }
+    SoARef<T> operator*() const { return _ref; }
+    const SoARef<T> *operator->() const { return &_ref; }
+
+private:
+    SoARef<T> _ref{typename SoARef<T>::Pointers{}};
+    bool _valid = false;
+};
+
+/**
+ * @typedef ComponentRef
+ * @brief What component accessors return: T& for packed components, SoARef<T> for SoA ones
+ */
+template <typename T>
+using ComponentRef = std::conditional_t<isSoA<T>, SoARef<T>, T &>;
+
+/**
+ * @typedef ComponentPtr
+ * @brief Nullable counterpart of ComponentRef: T* or SoAPtr<T>
+ */
+template <typename T>
+using ComponentPtr = std::conditional_t<isSoA<T>, SoAPtr<T>, T *>;
+
+/**
+ * @brief Takes the address of a component reference
+ * @param ref Reference returned by a component accessor
+ * @return &ref for packed components, a SoAPtr for SoA ones
+ */
+template <typename T>
+ComponentPtr<T> componentAddress(ComponentRef<T> ref) {
+    if constexpr (isSoA<T>) {
+        return SoAPtr<T>(ref);
+    } else {
+        return &ref;
+    }
+}
+
+/**
+ * @class SoASpan
+ * @brief Column spans of a SoA storage, parallel to its packed entity array
+ * @tparam T SoA component type
+ *
+ * Valid until the next structural change of the storage. Columns of two storages
+ * line up only if both hold the same entities in the same packed order.
+ */
+template <typename T>
+class SoASpan {
+public:
+    using Pointers = typename SoARef<T>::Pointers;
+
+    SoASpan() = default;
+
+    SoASpan(Span<const Entity> entities, Pointers columns) : _entities(entities), _columns(columns) {}
+
+    /** Owning entity of each row */
+    Span<const Entity> entities() const { return _entities; }
+
+    /** Number of rows */
+    std::size_t size() const { return _entities.size(); }
+
+    /** First element of every column */
+    Pointers pointers() const { return _columns; }
+
+    /**
+     * @brief Gets one column by member pointer, e.g. `columns.column<&Position::x>()`
+     */
+    template <auto Member>
+    auto column() const {
+        return get<soaIndexOf<T, Member>()>();
+    }
+
+    /**
+     * @brief Gets one column by index
+     */
+    template <std::size_t I>
+    Span<SoAField<T, I>> get() const {
+        return Span<SoAField<T, I>>(std::get<I>(_columns), _entities.size());
+    }
+
+private:
+    Span<const Entity> _entities;
+    Pointers _columns{};
+};
+
+/**
+ * @class SoAColumns
+ * @brief Column container used by BasicComponentStorage for SoA components
+ * @tparam T SoA component type
+ *
+ * Mirrors the subset of std::vector used by the storage, with SoARef in place of T&.
+ */
+template <typename T>
+class SoAColumns {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                  "SoA components must be trivially copyable and default-constructible");
+
+    using Layout = SoALayout<T>;
+    using Indices = std::make_index_sequence<Layout::count>;
+
+    template <typename Fields>
+    struct ColumnsOf;
+
+    template <typename... Fs>
+    struct ColumnsOf<std::tuple<Fs...>> {
+        using type = std::tuple<AlignedColumn<Fs>...>;
+    };
+
+    using Columns = typename ColumnsOf<typename Layout::Fields>::type;
+
+public:
+    explicit SoAColumns(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : _columns(makeColumns(resource, Indices{})) {}
+
+    std::size_t size() const { return _size; }
+
+    SoARef<T> operator[](std::size_t index) {
+        return SoARef<T>(pointersAt(index, Indices{}));
+    }
+
+    SoARef<T> back() {
+        return (*this)[_size - 1];
+    }
+
+    /**
+     * @brief Appends a component, built from args like std::vector::emplace_back
+     */
+    template <typename... Args>
+    void emplace_back(Args &&...args) {
+        reserve(_size + 1);
+        T value = makeValue(std::forward<Args>(args)...);
+        pushUnchecked(value, Indices{});
+        ++_size;
+    }
+
+    void pop_back() {
+        std::apply([](auto &...column) { (column.pop_back(), ...); }, _columns);
+        --_size;
+    }
+
+    void reserve(std::size_t count) {
+        if (count > capacity()) {
+            std::size_t grown = std::max(count, capacity() * 2);
+            std::apply([grown](auto &...column) { (column.reserve(grown), ...); }, _columns);
+        }
+    }
+
+    void resize(std::size_t count) {
+        std::apply([count](auto &...column) { (column.resize(count), ...); }, _columns);
+        _size = count;
+    }
+
+    void clear() {
+        std::apply([](auto &...column) { (column.clear(), ...); }, _columns);
+        _size = 0;
+    }
+
+    /**
+     * @brief Exchanges two rows, field by field
+     */
+    void swapRows(std::size_t a, std::size_t b) {
+        std::apply([a, b](auto &...column) { (std::swap(column.data()[a], column.data()[b]), ...); }, _columns);
+    }
+
+    /**
+     * @brief Gets the first element of every column
+     */
+    typename SoARef<T>::Pointers columnData() {
+        return pointersAt(0, Indices{});
+    }
+
+    /**
+     * @brief Writes the columns to a snapshot, one block per column
+     */
+    void saveSnapshot(SnapshotWriter &writer) const {
+        std::apply([&writer, this](const auto &...column) { (writer.writeArray(column.data(), _size), ...); }, _columns);
+    }
+
+    /**
+     * @brief Reads count rows written by saveSnapshot()
+     */
+    void loadSnapshot(SnapshotReader &reader, std::size_t count) {
+        resize(count);
+        std::apply([&reader, count](auto &...column) { (reader.readArray(column.data(), count), ...); }, _columns);
+    }
+
+private:
+    Columns _columns;
+    std::size_t _size = 0;
+
+    /** Rows every column can hold without growing (block sizes differ between field types) */
+    std::size_t capacity() const {
+        return std::apply([](const auto &...column) { return std::min({column.capacity()...}); }, _columns);
+    }
+
+    template <std::size_t... Is>
+    static Columns makeColumns(std::pmr::memory_resource *resource, std::index_sequence<Is...>) {
+        return Columns(((void)Is, std::tuple_element_t<Is, Columns>(resource))...);
+    }
+
+    template <std::size_t... Is>
+    typename SoARef<T>::Pointers pointersAt(std::size_t index, std::index_sequence<Is...>) {
+        return typename SoARef<T>::Pointers(std::get<Is>(_columns).data() + index...);
+    }
+
+    template <std::size_t... Is>
+    void pushUnchecked(const T &value, std::index_sequence<Is...>) {
+        (std::get<Is>(_columns).pushUnchecked(value.*std::get<Is>(Layout::members)), ...);
+    }
+
+    template <typename... Args>
+    static T makeValue(Args &&...args) {
+        if constexpr (std::is_constructible_v<T, Args &&...>) {
+            return T(std::forward<Args>(args)...);
+        } else {
+            return T{std::forward<Args>(args)...};
+        }
+    }
+};
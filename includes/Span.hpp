@@ -0,0 +1,46 @@
+/**
+ * @file Span.hpp
+ * @brief Lightweight non-owning view over a contiguous sequence
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class Span
+ * @brief Non-owning pointer + size view over contiguous elements (C++17 stand-in for std::span)
+ * @tparam T Element type (const-qualify it for read-only views)
+ *
+ * A span never owns its elements: it stays valid only as long as the underlying
+ * container is neither destroyed nor resized.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using iterator = T *;
+
+    Span() = default;
+
+    Span(T *data, std::size_t size) : _data(data), _size(size) {}
+
+    template <typename U, typename Alloc>
+    Span(std::vector<U, Alloc> &vector) : _data(vector.data()), _size(vector.size()) {}
+
+    template <typename U, typename Alloc>
+    Span(const std::vector<U, Alloc> &vector) : _data(vector.data()), _size(vector.size()) {}
+
+    T *data() const { return _data; }
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    T *begin() const { return _data; }
+    T *end() const { return _data + _size; }
+
+    T &operator[](std::size_t index) const { return _data[index]; }
+
+private:
+    T *_data = nullptr;
+    std::size_t _size = 0;
+};
@@ -4,12 +4,48 @@
  */
 #pragma once
 
+#include "EntitySet.hpp"
+#include "Profiler.hpp"
+#include "Span.hpp"
 #include "Types.hpp"
 #include <atomic>
 #include <cmath>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Archetype;
+
+/**
+ * @struct Reads
+ * @brief Tag listing the component types a system only reads
+ * @tparam Ts Component types read by the system
+ */
+template <typename... Ts>
+struct Reads {};
+
+/**
+ * @struct Writes
+ * @brief Tag listing the component types a system reads and writes
+ * @tparam Ts Component types written by the system
+ */
+template <typename... Ts>
+struct Writes {};
+
+/**
+ * @brief Built-in frame phases, run in ascending order by SystemManager::runFrame()
+ *
+ * Any other std::uint32_t value can be used to insert custom phases in between.
+ */
+enum SystemPhase : std::uint32_t {
+    PHASE_INPUT = 100,
+    PHASE_SIMULATION = 200,
+    PHASE_PHYSICS = 300,
+    PHASE_RENDER = 400,
+};
 
 /**
  * @class System
@@ -20,15 +56,37 @@
  */
 class System {
 public:
-    /** Set of entities that match this system's required component signature */
-    std::set<Entity> entities;
+    /** Default catch-up cap: whole overdue steps a late system still runs in one execution */
+    static constexpr std::size_t DEFAULT_MAX_CATCH_UP_STEPS = 8;
+
+    /**
+     * Entities that match this system's required component signature, packed
+     * contiguously (O(1) insertion/removal, order not stable)
+     */
+    EntitySet entities;
+
+    /**
+     * Archetypes whose signature includes this system's signature
+     * (only filled in archetype storage mode). Iterate their chunks to stream
+     * through the matching components column by column.
+     */
+    std::vector<Archetype *> archetypes;
+
+#if ECS_ENABLE_PROFILING
+    /** Profiling counters, updated by runProfiled() */
+    SystemCounters profile;
+
+    /** Name of the system in stats and trace events, set at registration */
+    std::string profileName;
+#endif
 
     /**
      * @brief Get all entities currently managed by this system
-     * @return Set of entity IDs that this system operates on
+     * @return Non-owning view over the entity IDs this system operates on,
+     *         valid until the system's membership changes
      */
-    std::set<Entity> getEntities() const {
-        return entities;
+    Span<const Entity> getEntities() const {
+        return entities.span();
     }
 
     /**
@@ -80,29 +138,137 @@ public:
         return _threshold;
     }
 
+    /**
+     * @brief Discard the accumulated delta time after an execution
+     */
+    void consumeDelta() { _delta = 0.0f; }
+
+    /**
+     * @brief Set how many fixed steps a single execution may run to catch up
+     * @param steps Maximum number of update() calls per execution (at least one)
+     *
+     * A late system runs one step per whole threshold accumulated, so a frame three
+     * steps late runs three, up to the cap (DEFAULT_MAX_CATCH_UP_STEPS by default).
+     * Beyond the cap, whole overdue steps are dropped so a stall cannot snowball into
+     * ever longer frames; the fractional remainder is always kept. Use one step for
+     * systems that should never run twice in a frame.
+     */
+    void setMaxCatchUpSteps(std::size_t steps) {
+        _maxCatchUpSteps = steps > 0 ? steps : 1;
+    }
+
+    /**
+     * @brief Get the maximum number of fixed steps per execution
+     * @return Catch-up step cap
+     */
+    std::size_t getMaxCatchUpSteps() const {
+        return _maxCatchUpSteps;
+    }
+
+    /**
+     * @brief Take the fixed steps due from the accumulated delta time
+     * @return Number of update() calls to run (0 if not due), each with getThreshold()
+     *
+     * Subtracts the steps taken from the accumulated time instead of discarding it;
+     * only the whole steps beyond the catch-up cap are dropped.
+     */
+    std::size_t consumeSteps() {
+        if (!canExecute()) {
+            return 0;
+        }
+        auto steps = static_cast<std::size_t>(_delta / _threshold);
+        if (steps > _maxCatchUpSteps) {
+            steps = _maxCatchUpSteps;
+        }
+        _delta -= static_cast<float>(steps) * _threshold;
+        if (_delta >= _threshold) {
+            _delta = std::fmod(_delta, _threshold);
+        }
+        return steps;
+    }
+
+    /**
+     * @brief Set the frame phase the system runs in
+     * @param phase Phase number (see SystemPhase); lower phases run first
+     */
+    void setPhase(std::uint32_t phase) {
+        _phase = phase;
+    }
+
+    /**
+     * @brief Get the frame phase the system runs in
+     * @return Phase number (PHASE_SIMULATION by default)
+     */
+    std::uint32_t getPhase() const {
+        return _phase;
+    }
+
+    /**
+     * @brief Declare the components this system reads and writes
+     * @param reads Components only read by the system
+     * @param writes Components written by the system
+     *
+     * Used by SystemManager::runFrame() to run systems without conflicting
+     * accesses concurrently. A system that never declared its access is
+     * considered to conflict with every other system.
+     */
+    void setAccess(Signature reads, Signature writes) {
+        _reads = reads;
+        _writes = writes;
+        _hasAccess = true;
+    }
+
+    /**
+     * @brief Check if this system must not run concurrently with another one
+     * @param other The other system
+     * @return True if either system writes a component the other one accesses
+     */
+    bool conflictsWith(const System &other) const {
+        if (!_hasAccess || !other._hasAccess) {
+            return true;
+        }
+        return _writes.intersects(other._reads | other._writes) || other._writes.intersects(_reads);
+    }
+
+    /**
+     * @brief Runs one invocation of the system, recording it when profiling is compiled in
+     * @param fn Callable running the system (typically calling update())
+     */
+    template <typename Fn>
+    void runProfiled(Fn &&fn) {
+#if ECS_ENABLE_PROFILING
+        Profiler::global().measure(profile, entities.size(), profileName.c_str(), std::forward<Fn>(fn));
+#else
+        std::forward<Fn>(fn)();
+#endif
+    }
+
     /**
      * @brief Execute a task when enough time has accumulated
      * @param deltaTime Current frame's delta time
-     * @param task Function to execute when threshold is reached
-     * @param scheduler Function that schedules the task execution (e.g. thread pool)
+     * @param task Callable taking (float deltaTime), run once per due step with the threshold
+     * @param scheduler Callable taking the job to run (e.g. ThreadPool::submit or a direct call)
      *
      * This method provides thread-safe execution of system logic based on time thresholds.
      * It prevents multiple concurrent executions of the same system by using atomic flags.
+     * The job handed to the scheduler holds the task by value next to two scalars, so it
+     * fits ThreadPool's inline task storage when the task itself is small; nothing is
+     * type-erased here. Time accumulated while the previous job was running is kept and
+     * caught up (see setMaxCatchUpSteps()).
      */
-    void executeWhenPossible(float deltaTime,
-                             std::function<void(float)> task,
-                             std::function<void(std::function<void()>)> scheduler) {
+    template <typename Task, typename Scheduler>
+    void executeWhenPossible(float deltaTime, Task &&task, Scheduler &&scheduler) {
         addDelta(deltaTime);
-        if (canExecute() && !_isTaskRunning.load(std::memory_order_acquire)) {
-            _isTaskRunning.store(true, std::memory_order_release);
-            float totalDelta = getThreshold();
+        if (canExecute() && !_isTaskRunning.exchange(true, std::memory_order_acq_rel)) {
+            std::size_t steps = consumeSteps();
+            float stepDelta = getThreshold();
 
-            scheduler([this, totalDelta, task]() {
-                task(totalDelta);
+            std::forward<Scheduler>(scheduler)([this, steps, stepDelta, task = std::forward<Task>(task)]() mutable {
+                for (std::size_t step = 0; step < steps; ++step) {
+                    runProfiled([&]() { task(stepDelta); });
+                }
                 _isTaskRunning.store(false, std::memory_order_release);
             });
-
-            _delta = 0.0f;
         }
     }
 
@@ -113,6 +279,21 @@ private:
     /** Time threshold between executions (default: 1/30 seconds) */
     float _threshold = 1.0f / 30.0f;
 
+    /** Maximum number of fixed steps run by one execution */
+    std::size_t _maxCatchUpSteps = DEFAULT_MAX_CATCH_UP_STEPS;
+
+    /** Frame phase the system runs in */
+    std::uint32_t _phase = PHASE_SIMULATION;
+
     /** Flag to prevent concurrent execution of the system */
     std::atomic_bool _isTaskRunning{false};
+
+    /** Components read by the system */
+    Signature _reads;
+
+    /** Components written by the system */
+    Signature _writes;
+
+    /** Whether the read/write sets were declared */
+    bool _hasAccess = false;
 };
@@ -4,10 +4,21 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <tuple>
 #include <unordered_map>
 #include <typeindex>
 #include <memory>
+#include <memory_resource>
+#include <vector>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include "ArchetypeStorage.hpp"
+#include "Span.hpp"
 #include "System.hpp"
+#include "ThreadPool.hpp"
 #include "Types.hpp"
 
 /**
@@ -21,6 +32,13 @@
 class SystemManager
 {
     public:
+        /**
+         * @brief Creates a system manager
+         * @param resource Memory resource backing the entity sets of the registered systems
+         */
+        explicit SystemManager(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : memoryResource(resource) {}
+
         /**
          * @brief Registers a new system
          * @tparam T System type to register
@@ -34,7 +52,17 @@ class SystemManager
             std::type_index typeName = typeid(T);
 
             auto system = std::make_shared<T>();
-            systems.insert({typeName, system});
+            system->entities.setMemoryResource(memoryResource);
+#if ECS_ENABLE_PROFILING
+            system->profileName = Profiler::typeName(typeid(T));
+#endif
+            if (systems.insert({typeName, system}).second) {
+                auto signature = signatures.find(typeName);
+                records.push_back({system, signature != signatures.end() ? signature->second : Signature{}});
+                matchArchetypes(*system, records.back().signature);
+                rebuildComponentIndex();
+                groupsDirty = true;
+            }
             return system;
         }
 
@@ -63,7 +91,39 @@ class SystemManager
         void setSignature(Signature signature)
         {
             std::type_index typeName = typeid(T);
-            signatures.insert({typeName, signature});
+            if (!signatures.insert({typeName, signature}).second) {
+                return;
+            }
+            auto system = systems.find(typeName);
+            if (system == systems.end()) {
+                return;
+            }
+            for (auto &record : records)
+            {
+                if (record.system == system->second) {
+                    record.signature = signature;
+                }
+            }
+            rebuildComponentIndex();
+            matchArchetypes(*system->second, signature);
+        }
+
+        /**
+         * @brief Notifies systems that a new archetype was created
+         * @param archetype The new archetype
+         *
+         * Appends the archetype to every system whose signature it satisfies.
+         */
+        void archetypeCreated(Archetype &archetype)
+        {
+            archetypes.push_back(&archetype);
+            for (auto const &record : records)
+            {
+                if (archetype.getSignature().contains(record.signature))
+                {
+                    record.system->archetypes.push_back(&archetype);
+                }
+            }
         }
 
         /**
@@ -81,37 +141,541 @@ class SystemManager
             }
         }
 
+        /**
+         * @brief Removes every entity from every system
+         *
+         * Used before membership is rebuilt from scratch, e.g. after loading a snapshot.
+         */
+        void clearEntities()
+        {
+            for (auto const &record : records)
+            {
+                record.system->entities.clear();
+            }
+        }
+
+        /**
+         * @brief Notifies the systems an entity may belong to that it has been destroyed
+         * @param entity The ID of the destroyed entity
+         * @param entitySignature The entity's signature before destruction
+         *
+         * Only the systems whose signature is a subset of entitySignature can hold the
+         * entity. Each one is found once, through the lowest bit of its signature, so a
+         * destroy visits the matching systems (plus the empty-signature ones) only.
+         */
+        void entityDestroyed(Entity entity, Signature entitySignature)
+        {
+            forEachSetBit(entitySignature, [&](ComponentTypeID bit) {
+                for (std::size_t index : lowestBitIndex[bit])
+                {
+                    const SystemRecord &record = records[index];
+                    if (entitySignature.contains(record.signature)) {
+                        record.system->entities.erase(entity);
+                    }
+                }
+            });
+            for (std::size_t index : matchAll)
+            {
+                records[index].system->entities.erase(entity);
+            }
+        }
+
         /**
          * @brief Updates systems when an entity's component signature changes
          * @param entity The entity whose signature changed
          * @param entitySignature The entity's new component signature
          *
          * Adds the entity to systems whose signatures match the entity's new signature,
-         * and removes it from systems that no longer match.
+         * and removes it from systems that no longer match. Tests every system; prefer
+         * the overload taking the previous signature when it is known.
          */
         void entitySignatureChanged(Entity entity, Signature entitySignature)
         {
-            for (auto const &pair : systems)
+            for (auto const &record : records)
             {
-                auto const &type = pair.first;
-                auto const &system = pair.second;
-                auto const &systemSignature = signatures[type];
+                updateMembership(record, entity, entitySignature);
+            }
+        }
+
+        /**
+         * @brief Updates systems when an entity's component signature changes
+         * @param entity The entity whose signature changed
+         * @param oldSignature The entity's previous component signature
+         * @param newSignature The entity's new component signature
+         *
+         * Only the systems whose signature contains one of the flipped bits (plus the
+         * systems with an empty signature, which match every entity) are re-tested.
+         */
+        void entitySignatureChanged(Entity entity, Signature oldSignature, Signature newSignature)
+        {
+            Signature changed = oldSignature ^ newSignature;
+            if (changed.none()) {
+                return;
+            }
+            forEachSetBit(changed, [&](ComponentTypeID bit) {
+                for (std::size_t index : componentIndex[bit])
+                {
+                    updateMembership(records[index], entity, newSignature);
+                }
+            });
+            for (std::size_t index : matchAll)
+            {
+                records[index].system->entities.insert(entity);
+            }
+        }
+
+        /**
+         * @brief Updates systems after the signatures of many entities changed
+         * @param entities The entities whose signature changed
+         * @param oldSignatures Previous signature of each entity
+         * @param newSignatures New signature of each entity
+         *
+         * Every interested system (one requiring a flipped bit, or with an empty
+         * signature) is visited once and tests the entities in a single pass.
+         */
+        void entitySignaturesChanged(Span<const Entity> entities, Span<const Signature> oldSignatures, Span<const Signature> newSignatures)
+        {
+            Signature changed;
+            for (std::size_t i = 0; i < entities.size(); ++i)
+            {
+                changed |= oldSignatures[i] ^ newSignatures[i];
+            }
+            if (changed.none()) {
+                return;
+            }
+            std::vector<bool> interested(records.size(), false);
+            forEachSetBit(changed, [&](ComponentTypeID bit) {
+                for (std::size_t index : componentIndex[bit])
+                {
+                    interested[index] = true;
+                }
+            });
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                const SystemRecord &record = records[index];
+                if (interested[index]) {
+                    record.system->entities.reserve(record.system->entities.size() + entities.size());
+                    for (std::size_t i = 0; i < entities.size(); ++i)
+                    {
+                        if ((oldSignatures[i] ^ newSignatures[i]).intersects(record.signature)) {
+                            updateMembership(record, entities[i], newSignatures[i]);
+                        }
+                    }
+                } else if (record.signature.none()) {
+                    for (std::size_t i = 0; i < entities.size(); ++i)
+                    {
+                        if (oldSignatures[i] != newSignatures[i]) {
+                            record.system->entities.insert(entities[i]);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Sets the number of worker threads used by runFrame()
+         * @param threadCount Number of workers (at least one)
+         *
+         * Replaces the current pool; must not be called while a frame is running.
+         */
+        void setThreadCount(std::size_t threadCount)
+        {
+            pool = std::make_unique<ThreadPool>(threadCount);
+        }
+
+        /**
+         * @brief Gets the thread pool used by runFrame(), creating it if needed
+         * @return Reference to the pool
+         */
+        ThreadPool &getThreadPool()
+        {
+            if (!pool) {
+                pool = std::make_unique<ThreadPool>();
+            }
+            return *pool;
+        }
 
-                if ((entitySignature & systemSignature) == systemSignature)
+        /**
+         * @brief Runs one frame of every system that is due, phase by phase, in parallel where possible
+         * @param deltaTime Time elapsed since the previous frame (in seconds)
+         * @param atPhaseEnd Callable taking (std::uint32_t phase), called after each phase
+         *                   that ran at least one system (e.g. to apply deferred commands)
+         *
+         * Systems are grouped by phase (System::setPhase) and, inside a phase, by rate:
+         * systems of a rate group share the same threshold and catch-up cap and their
+         * accumulators are aligned when the group forms, so they are all due in the same
+         * frames. Each system runs update() with its threshold once per whole threshold
+         * accumulated, up to its catch-up cap; the leftover time is kept (see
+         * System::setTPS and System::setMaxCatchUpSteps).
+         *
+         * Phases run in ascending order. The systems of a phase due this frame form one
+         * batch, run on the thread pool as a dependency graph: a system waits for every
+         * earlier-registered system of the batch it conflicts with (see System::setAccess),
+         * and systems without conflicts run concurrently. The batch is a barrier: the
+         * next phase starts once every system of the current one has finished. The first
+         * exception thrown by a system is rethrown at the end of its phase, and the
+         * remaining phases are skipped.
+         */
+        template <typename PhaseEnd>
+        void runFrame(float deltaTime, PhaseEnd &&atPhaseEnd)
+        {
+            refreshGroups();
+            std::vector<System *> due;
+            std::vector<std::size_t> steps;
+            std::vector<std::size_t> order;
+            for (std::size_t first = 0; first < groups.size();)
+            {
+                std::uint32_t phase = groups[first].phase;
+                order.clear();
+                for (; first < groups.size() && groups[first].phase == phase; ++first)
                 {
-                    system->entities.insert(entity);
+                    for (std::size_t index : groups[first].members)
+                    {
+                        System &system = *records[index].system;
+                        system.addDelta(deltaTime);
+                        if (system.canExecute()) {
+                            order.push_back(index);
+                        }
+                    }
+                }
+                if (order.empty()) {
+                    continue;
                 }
-                else
+                std::sort(order.begin(), order.end());
+                due.clear();
+                steps.clear();
+                for (std::size_t index : order)
                 {
-                    system->entities.erase(entity);
+                    due.push_back(records[index].system.get());
+                    steps.push_back(due.back()->consumeSteps());
                 }
+                runBatch(due, steps);
+                atPhaseEnd(phase);
+            }
+        }
+
+        /**
+         * @brief Runs one frame of every system that is due, with nothing done between phases
+         * @param deltaTime Time elapsed since the previous frame (in seconds)
+         */
+        void runFrame(float deltaTime)
+        {
+            runFrame(deltaTime, [](std::uint32_t) {});
+        }
+
+        /**
+         * @brief Gets the profiling counters of every system, in registration order
+         * @return One entry per system (empty unless ECS_ENABLE_PROFILING is set)
+         *
+         * Counters are written by the threads running the systems: read them between frames.
+         */
+        std::vector<SystemStats> getSystemStats() const
+        {
+            std::vector<SystemStats> stats;
+#if ECS_ENABLE_PROFILING
+            stats.reserve(records.size());
+            for (auto const &record : records)
+            {
+                stats.push_back(Profiler::toStats(record.system->profileName, record.system->profile));
+            }
+#endif
+            return stats;
+        }
+
+        /**
+         * @brief Resets the profiling counters of every system
+         */
+        void resetSystemStats()
+        {
+#if ECS_ENABLE_PROFILING
+            for (auto const &record : records)
+            {
+                record.system->profile.reset();
             }
+#endif
+        }
+
+        /**
+         * @brief Calls a function for every entity of a system, spread across the thread pool
+         * @param system System whose entities are processed
+         * @param chunkSize Number of entities per task (0 picks one range per worker)
+         * @param fn Callable taking (Entity), called concurrently from several threads
+         *
+         * Returns once every entity was processed. The packed entity list is split
+         * in place, so no structural change may happen concurrently.
+         */
+        template <typename Fn>
+        void parallelForEach(System &system, std::size_t chunkSize, Fn &&fn)
+        {
+            const Entity *entities = system.entities.data();
+            getThreadPool().parallelFor(system.entities.size(), chunkSize, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    fn(entities[i]);
+                }
+            });
         }
 
     private:
+        /**
+         * @struct SystemRecord
+         * @brief A registered system and its required signature
+         */
+        struct SystemRecord {
+            std::shared_ptr<System> system;
+            Signature signature;
+        };
+
+        /** Memory resource backing the entity sets of the systems */
+        std::pmr::memory_resource *memoryResource{};
+
+        /** Systems in registration order */
+        std::vector<SystemRecord> records{};
+
+        /** For each component bit, indices (into records) of the systems requiring it */
+        std::array<std::vector<std::size_t>, MAX_COMPONENTS> componentIndex{};
+
+        /** For each component bit, indices (into records) of the systems whose lowest required bit it is */
+        std::array<std::vector<std::size_t>, MAX_COMPONENTS> lowestBitIndex{};
+
+        /** Indices (into records) of the systems with an empty signature */
+        std::vector<std::size_t> matchAll{};
+
+        /** Worker threads used by runFrame(), created on first use */
+        std::unique_ptr<ThreadPool> pool{};
+
         /** Maps system types to their required component signatures */
         std::unordered_map<std::type_index, Signature> signatures{};
 
         /** Maps system types to their instances */
         std::unordered_map<std::type_index, std::shared_ptr<System>> systems{};
+
+        /** Every archetype created so far (archetype storage mode only) */
+        std::vector<Archetype *> archetypes{};
+
+        /**
+         * @struct RateGroup
+         * @brief Systems of one phase sharing a threshold and catch-up cap
+         */
+        struct RateGroup {
+            std::uint32_t phase;
+            float threshold;
+            std::size_t maxCatchUpSteps;
+
+            /** Indices (into records) of the members, in registration order */
+            std::vector<std::size_t> members;
+        };
+
+        /** Rate groups sorted by phase then threshold, rebuilt when a system changes rate or phase */
+        std::vector<RateGroup> groups{};
+
+        /** Whether a system was registered since the groups were built */
+        bool groupsDirty = true;
+
+        /**
+         * @brief Rebuilds the rate groups if a system was added or changed phase, rate or catch-up cap
+         *
+         * Only systems that changed group (or were just registered) are re-aligned:
+         * they get the accumulated time of a member that stayed in the group, or of its
+         * first member if the group is new, so the whole group is due in the same frames
+         * from now on. Systems that stayed keep their own accumulated time, so changing
+         * the rate of one system does not shift the timeline of the others.
+         */
+        void refreshGroups()
+        {
+            if (!groupsDirty) {
+                for (const RateGroup &group : groups)
+                {
+                    for (std::size_t index : group.members)
+                    {
+                        const System &system = *records[index].system;
+                        if (system.getPhase() != group.phase || system.getThreshold() != group.threshold ||
+                            system.getMaxCatchUpSteps() != group.maxCatchUpSteps) {
+                            groupsDirty = true;
+                        }
+                    }
+                }
+                if (!groupsDirty) {
+                    return;
+                }
+            }
+            groupsDirty = false;
+            using GroupKey = std::tuple<std::uint32_t, float, std::size_t>;
+            std::vector<bool> wasGrouped(records.size(), false);
+            std::vector<GroupKey> previousKey(records.size());
+            for (const RateGroup &group : groups)
+            {
+                for (std::size_t index : group.members)
+                {
+                    wasGrouped[index] = true;
+                    previousKey[index] = std::make_tuple(group.phase, group.threshold, group.maxCatchUpSteps);
+                }
+            }
+            std::vector<std::size_t> sorted(records.size());
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                sorted[index] = index;
+            }
+            auto key = [this](std::size_t index) {
+                const System &system = *records[index].system;
+                return std::make_tuple(system.getPhase(), system.getThreshold(), system.getMaxCatchUpSteps());
+            };
+            std::stable_sort(sorted.begin(), sorted.end(), [&key](std::size_t a, std::size_t b) { return key(a) < key(b); });
+            groups.clear();
+            for (std::size_t index : sorted)
+            {
+                const System &system = *records[index].system;
+                if (groups.empty() || key(groups.back().members.front()) != key(index)) {
+                    groups.push_back({system.getPhase(), system.getThreshold(), system.getMaxCatchUpSteps(), {}});
+                }
+                groups.back().members.push_back(index);
+            }
+            for (const RateGroup &group : groups)
+            {
+                auto stayed = [&](std::size_t index) { return wasGrouped[index] && previousKey[index] == key(index); };
+                auto anchor = std::find_if(group.members.begin(), group.members.end(), stayed);
+                const System &reference = *records[anchor != group.members.end() ? *anchor : group.members.front()].system;
+                for (std::size_t index : group.members)
+                {
+                    System &member = *records[index].system;
+                    if (!stayed(index) && &member != &reference) {
+                        member.consumeDelta();
+                        member.addDelta(reference.getDelta());
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Runs a batch of systems on the thread pool as a dependency graph and waits for it
+         * @param due Systems of the batch, in registration order
+         * @param steps Number of update() calls of each system
+         */
+        void runBatch(const std::vector<System *> &due, const std::vector<std::size_t> &steps)
+        {
+            struct Node {
+                std::vector<std::size_t> successors;
+                std::atomic<std::size_t> dependencies{0};
+            };
+            std::vector<Node> graph(due.size());
+            for (std::size_t j = 0; j < due.size(); ++j)
+            {
+                for (std::size_t i = 0; i < j; ++i)
+                {
+                    if (due[i]->conflictsWith(*due[j])) {
+                        graph[i].successors.push_back(j);
+                        graph[j].dependencies.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            ThreadPool &threads = getThreadPool();
+            std::atomic<std::size_t> remaining{due.size()};
+            std::exception_ptr failure;
+            std::mutex failureMutex;
+
+            auto run = [&](auto &self, std::size_t index) -> void {
+                try {
+                    System &system = *due[index];
+                    for (std::size_t step = 0; step < steps[index]; ++step)
+                    {
+                        system.runProfiled([&system]() { system.update(system.getThreshold()); });
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+                for (std::size_t successor : graph[index].successors)
+                {
+                    if (graph[successor].dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        threads.submit([&self, successor]() { self(self, successor); });
+                    }
+                }
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            };
+
+            std::vector<std::size_t> roots;
+            for (std::size_t i = 0; i < due.size(); ++i)
+            {
+                if (graph[i].dependencies.load(std::memory_order_relaxed) == 0) {
+                    roots.push_back(i);
+                }
+            }
+            for (std::size_t root : roots)
+            {
+                threads.submit([&run, root]() { run(run, root); });
+            }
+            threads.helpUntil([&remaining]() { return remaining.load(std::memory_order_acquire) == 0; });
+
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+
+        /**
+         * @brief Refills System::archetypes with the existing archetypes matching a signature
+         * @param system The system to update
+         * @param signature Its signature
+         *
+         * Later archetypes are appended by archetypeCreated(); this catches up with the
+         * ones created before the system was registered or got its signature.
+         */
+        void matchArchetypes(System &system, Signature signature)
+        {
+            system.archetypes.clear();
+            for (auto *archetype : archetypes)
+            {
+                if (archetype->getSignature().contains(signature))
+                {
+                    system.archetypes.push_back(archetype);
+                }
+            }
+        }
+
+        /**
+         * @brief Rebuilds the component bit -> interested systems index
+         */
+        void rebuildComponentIndex()
+        {
+            for (auto &systemsForBit : componentIndex)
+            {
+                systemsForBit.clear();
+            }
+            for (auto &systemsForBit : lowestBitIndex)
+            {
+                systemsForBit.clear();
+            }
+            matchAll.clear();
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                if (records[index].signature.none()) {
+                    matchAll.push_back(index);
+                }
+                bool lowest = true;
+                forEachSetBit(records[index].signature, [&](ComponentTypeID bit) {
+                    componentIndex[bit].push_back(index);
+                    if (lowest) {
+                        lowestBitIndex[bit].push_back(index);
+                        lowest = false;
+                    }
+                });
+            }
+        }
+
+        /**
+         * @brief Adds or removes an entity from a system based on its signature
+         */
+        static void updateMembership(const SystemRecord &record, Entity entity, const Signature &entitySignature)
+        {
+            if (entitySignature.contains(record.signature))
+            {
+                record.system->entities.insert(entity);
+            }
+            else
+            {
+                record.system->entities.erase(entity);
+            }
+        }
 };
@@ -0,0 +1,88 @@
+/**
+ * @file Tag.hpp
+ * @brief Storage-free layout for empty marker components (tags)
+ *
+ * An empty, trivial component such as `struct Frozen {};` carries no data: owning
+ * it is the whole information. Such tags are detected automatically (isTag) and
+ * stored without any per-entity component memory, only as a bit of the Signature
+ * and a membership entry in the storage's entity set (or the archetype itself).
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include "Snapshot.hpp"
+#include "Types.hpp"
+
+/**
+ * @var isTag
+ * @brief True if T is an empty, trivial component, stored without per-entity data
+ */
+template <typename T>
+inline constexpr bool isTag = std::is_empty_v<T> && std::is_trivial_v<T>;
+
+/**
+ * @brief Gets the instance every stored tag of a type refers to
+ * @tparam T Tag component type
+ * @return Reference to a single, process-wide T (stateless, so sharing it is safe)
+ */
+template <typename T>
+T &tagInstance() {
+    static T instance{};
+    return instance;
+}
+
+/**
+ * @class TagColumn
+ * @brief Component container used by BasicComponentStorage for tags
+ * @tparam T Tag component type
+ *
+ * Mirrors the subset of std::vector used by the storage, but only counts its
+ * elements: every index refers to tagInstance<T>(), which is indistinguishable
+ * from any other T since T has no state. Nothing is allocated.
+ */
+template <typename T>
+class TagColumn {
+    static_assert(isTag<T>, "TagColumn only holds empty, trivial component types");
+
+public:
+    explicit TagColumn(std::pmr::memory_resource * = std::pmr::get_default_resource()) {}
+
+    std::size_t size() const { return _size; }
+
+    T &operator[](std::size_t) { return tagInstance<T>(); }
+
+    T &back() { return tagInstance<T>(); }
+
+    /**
+     * @brief Appends a tag; the arguments (another T at most) carry nothing to keep
+     */
+    template <typename... Args>
+    void emplace_back(Args &&...) {
+        ++_size;
+    }
+
+    void pop_back() { --_size; }
+
+    void reserve(std::size_t) {}
+
+    void resize(std::size_t count) { _size = count; }
+
+    void clear() { _size = 0; }
+
+    /**
+     * @brief Writes nothing: the owners saved by the storage are the whole content
+     */
+    void saveSnapshot(SnapshotWriter &) const {}
+
+    /**
+     * @brief Restores count tags written by saveSnapshot()
+     */
+    void loadSnapshot(SnapshotReader &, std::size_t count) {
+        resize(count);
+    }
+
+private:
+    std::size_t _size = 0;
+};
@@ -0,0 +1,316 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief Work-stealing thread pool used to run systems in parallel
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "InplaceTask.hpp"
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads, each owning a task deque
+ *
+ * Workers pop tasks from the back of their own deque and steal from the front of
+ * the others' deques when they run out of work. Tasks submitted from a worker go to
+ * that worker's deque; tasks submitted from outside are spread round-robin.
+ *
+ * Threads waiting for tasks to complete should use helpUntil(), which executes
+ * pending tasks instead of blocking, so waiting from inside a task never deadlocks.
+ *
+ * Idle threads sleep on condition variables and count themselves as sleepers or
+ * waiters, so submitting or completing a task only takes the sleep mutex when some
+ * thread actually has to be woken up.
+ */
+class ThreadPool {
+public:
+    /** Type of the tasks run by the pool, stored inline when small */
+    using Task = InplaceTask;
+
+    /**
+     * @brief Starts the worker threads
+     * @param threadCount Number of workers (at least one)
+     */
+    explicit ThreadPool(std::size_t threadCount = defaultThreadCount()) {
+        threadCount = std::max<std::size_t>(1, threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            _queues.push_back(std::make_unique<Queue>());
+        }
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            _workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    /**
+     * @brief Runs the remaining tasks and joins the worker threads
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _stopping.store(true, std::memory_order_seq_cst);
+        }
+        _wakeUp.notify_all();
+        _progress.notify_all();
+        for (auto &worker : _workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Gets the default number of workers
+     * @return Hardware concurrency minus the calling thread, at least one
+     */
+    static std::size_t defaultThreadCount() {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 1;
+    }
+
+    /**
+     * @brief Gets the number of worker threads
+     * @return Worker count
+     */
+    std::size_t size() const { return _workers.size(); }
+
+    /**
+     * @brief Queues a task
+     * @param task Callable to run on a worker thread
+     */
+    void submit(Task task) {
+        std::size_t index = (t_pool == this)
+            ? t_index
+            : _nextQueue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+        _pending.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+            _queues[index]->tasks.push_back(std::move(task));
+        }
+        bool sleeper = _sleepers.load(std::memory_order_seq_cst) > 0;
+        bool waiter = _waiters.load(std::memory_order_seq_cst) > 0;
+        if (sleeper || waiter) {
+            // Taking the mutex orders the notification after the sleeper's predicate check
+            { std::lock_guard<std::mutex> lock(_sleepMutex); }
+            if (sleeper) {
+                _wakeUp.notify_one();
+            }
+            if (waiter) {
+                _progress.notify_all();
+            }
+        }
+    }
+
+    /**
+     * @brief Runs one pending task on the calling thread, if any
+     * @return True if a task was run
+     */
+    bool runPendingTask() {
+        Task task;
+        std::size_t start = (t_pool == this) ? t_index : 0;
+        if (!take(start, task)) {
+            return false;
+        }
+        run(task);
+        return true;
+    }
+
+    /**
+     * @brief Runs pending tasks on the calling thread until a condition holds
+     * @param done Predicate checked between tasks
+     *
+     * Once there is nothing left to steal, the thread yields a few times and then
+     * sleeps until a task completes or is submitted. The sleep is bounded, so a
+     * predicate made true from outside the pool is still noticed, only later.
+     */
+    template <typename Predicate>
+    void helpUntil(Predicate &&done) {
+        std::size_t idleRounds = 0;
+        while (!done()) {
+            if (runPendingTask()) {
+                idleRounds = 0;
+                continue;
+            }
+            if (++idleRounds <= SPIN_ROUNDS) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _progress.wait_for(lock, MAX_HELPER_SLEEP, [this, &done]() {
+                return _pending.load(std::memory_order_seq_cst) > 0 || done();
+            });
+            _waiters.fetch_sub(1, std::memory_order_relaxed);
+            idleRounds = 0;
+        }
+    }
+
+    /**
+     * @brief Splits [0, count) into ranges and processes them in parallel
+     * @param count Number of items
+     * @param chunkSize Maximum number of items per range (0 picks one range per worker)
+     * @param fn Callable taking (std::size_t begin, std::size_t end)
+     *
+     * The calling thread processes the first range and then helps with the others;
+     * the call returns once every range is done (join barrier) and rethrows the first
+     * exception thrown by fn.
+     */
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Fn &&fn) {
+        if (count == 0) {
+            return;
+        }
+        if (chunkSize == 0) {
+            chunkSize = (count + size()) / (size() + 1);
+        }
+        std::size_t ranges = (count + chunkSize - 1) / chunkSize;
+        std::atomic<std::size_t> remaining{ranges};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        auto runRange = [&](std::size_t range) {
+            std::size_t begin = range * chunkSize;
+            std::size_t end = std::min(count, begin + chunkSize);
+            try {
+                fn(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        };
+
+        for (std::size_t range = 1; range < ranges; ++range) {
+            submit([&runRange, range]() { runRange(range); });
+        }
+        runRange(0);
+        helpUntil([&remaining]() { return remaining.load(std::memory_order_acquire) == 0; });
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+private:
+    /**
+     * @struct Queue
+     * @brief Task deque owned by one worker
+     */
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<std::size_t> _pending{0};
+    std::atomic<std::size_t> _nextQueue{0};
+    std::atomic_bool _stopping{false};
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    std::condition_variable _progress;
+
+    /** Number of workers asleep on _wakeUp */
+    std::atomic<std::size_t> _sleepers{0};
+
+    /** Number of helpUntil() callers asleep on _progress */
+    std::atomic<std::size_t> _waiters{0};
+
+    /** Yields of an idle helpUntil() caller before it goes to sleep */
+    static constexpr std::size_t SPIN_ROUNDS = 64;
+
+    /** Longest sleep of a helpUntil() caller between two checks of its predicate */
+    static constexpr std::chrono::milliseconds MAX_HELPER_SLEEP{1};
+
+    /** Pool owning the calling worker thread, if any */
+    static inline thread_local ThreadPool *t_pool = nullptr;
+
+    /** Index of the calling worker thread inside t_pool */
+    static inline thread_local std::size_t t_index = 0;
+
+    /**
+     * @brief Pops a task from a queue, or steals one from the others
+     * @param own Index of the queue to pop from first (from the back)
+     * @param task Set to the task taken
+     * @return True if a task was taken
+     */
+    bool take(std::size_t own, Task &task) {
+        if (_pending.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        {
+            Queue &queue = *_queues[own];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                _pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+        for (std::size_t offset = 1; offset < _queues.size(); ++offset) {
+            Queue &queue = *_queues[(own + offset) % _queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                _pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Runs a task, then wakes the helpUntil() callers whose predicate it may have satisfied
+     * @param task The task taken from a queue
+     */
+    void run(Task &task) {
+        task();
+        // Pairs with the fence in helpUntil(): either the waiter sees the effects of
+        // the task in its predicate, or this load sees the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_waiters.load(std::memory_order_relaxed) > 0) {
+            { std::lock_guard<std::mutex> lock(_sleepMutex); }
+            _progress.notify_all();
+        }
+    }
+
+    void workerLoop(std::size_t index) {
+        t_pool = this;
+        t_index = index;
+
+        while (true) {
+            Task task;
+            if (take(index, task)) {
+                run(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            _wakeUp.wait(lock, [this]() {
+                return _stopping.load(std::memory_order_seq_cst) || _pending.load(std::memory_order_seq_cst) > 0;
+            });
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (_stopping.load(std::memory_order_acquire) && _pending.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+};
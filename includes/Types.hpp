@@ -4,23 +4,106 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <bitset>
+#include <functional>
+#include <string>
 
 /**
  * @typedef Entity
  * @brief Entity identifier type
  *
  * Represents a unique identifier for an entity in the ECS system.
- * Implemented as a 32-bit unsigned integer for efficiency.
+ * Implemented as a 32-bit unsigned integer for efficiency, packing a slot index
+ * (low ENTITY_INDEX_BITS bits) and a generation (remaining high bits). The
+ * generation is bumped every time a slot is recycled, so a stale handle to a
+ * destroyed entity never aliases the entity that reuses its slot (until the
+ * generation wraps around).
  */
 using Entity = std::uint32_t;
 
+#ifndef ECS_ENTITY_INDEX_BITS
+/**
+ * @def ECS_ENTITY_INDEX_BITS
+ * @brief Number of Entity bits used for the slot index (override with -DECS_ENTITY_INDEX_BITS=N)
+ */
+#define ECS_ENTITY_INDEX_BITS 22
+#endif
+
+static_assert(ECS_ENTITY_INDEX_BITS > 0 && ECS_ENTITY_INDEX_BITS < 32,
+              "ECS_ENTITY_INDEX_BITS must leave room for a generation");
+
+/**
+ * @var ENTITY_INDEX_BITS
+ * @brief Number of low Entity bits holding the slot index
+ */
+constexpr unsigned ENTITY_INDEX_BITS = ECS_ENTITY_INDEX_BITS;
+
+/**
+ * @var ENTITY_INDEX_MASK
+ * @brief Mask extracting the slot index of an Entity (also the reserved null index)
+ */
+constexpr Entity ENTITY_INDEX_MASK = (Entity{1} << ENTITY_INDEX_BITS) - 1;
+
+/**
+ * @var ENTITY_GENERATION_MASK
+ * @brief Mask of a generation value once shifted down
+ */
+constexpr Entity ENTITY_GENERATION_MASK = ~Entity{0} >> ENTITY_INDEX_BITS;
+
+/**
+ * @var NULL_ENTITY
+ * @brief Handle that never refers to a living entity
+ */
+constexpr Entity NULL_ENTITY = ~Entity{0};
+
+/**
+ * @brief Extracts the slot index of an entity handle
+ * @param entity The entity handle
+ * @return Slot index, usable to index dense per-entity arrays
+ */
+constexpr Entity entityIndex(Entity entity)
+{
+    return entity & ENTITY_INDEX_MASK;
+}
+
+/**
+ * @brief Extracts the generation of an entity handle
+ * @param entity The entity handle
+ * @return Generation of the slot when the handle was created
+ */
+constexpr Entity entityGeneration(Entity entity)
+{
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+/**
+ * @brief Packs a slot index and a generation into an entity handle
+ * @param index Slot index (lower than ENTITY_INDEX_MASK)
+ * @param generation Generation (wrapped to the available bits)
+ * @return The entity handle
+ */
+constexpr Entity makeEntity(Entity index, Entity generation)
+{
+    return (index & ENTITY_INDEX_MASK) | ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS);
+}
+
+#ifndef ECS_MAX_ENTITIES
+/**
+ * @def ECS_MAX_ENTITIES
+ * @brief Compile-time default entity capacity (override with -DECS_MAX_ENTITIES=N)
+ */
+#define ECS_MAX_ENTITIES 5000
+#endif
+
 /**
  * @var MAX_ENTITIES
- * @brief Maximum number of entities allowed in the system
+ * @brief Default maximum number of entities allowed in the system
+ *
+ * Used when no capacity is given to CoordinatorConfig / EntityManager. Memory is
+ * only committed for the entities actually created, so a large value is cheap.
  */
-const Entity MAX_ENTITIES = 5000;
+const Entity MAX_ENTITIES = ECS_MAX_ENTITIES;
 
 /**
  * @typedef ComponentTypeID
@@ -31,19 +114,274 @@ const Entity MAX_ENTITIES = 5000;
  */
 using ComponentTypeID = std::uint8_t;
 
+#ifndef ECS_VERBOSE
+/**
+ * @def ECS_VERBOSE
+ * @brief Prints every component registration to stdout when 1 (override with -DECS_VERBOSE=1)
+ */
+#define ECS_VERBOSE 0
+#endif
+
+#ifndef ECS_MAX_COMPONENTS
+/**
+ * @def ECS_MAX_COMPONENTS
+ * @brief Number of component types, i.e. of Signature bits (override with -DECS_MAX_COMPONENTS=N)
+ */
+#define ECS_MAX_COMPONENTS 64
+#endif
+
+static_assert(ECS_MAX_COMPONENTS > 0 && ECS_MAX_COMPONENTS <= 256 && ECS_MAX_COMPONENTS % 64 == 0,
+              "ECS_MAX_COMPONENTS must be 64, 128, 192 or 256");
+
 /**
  * @var MAX_COMPONENTS
  * @brief Maximum number of component types allowed in the system
  *
- * Limited to 64 to match the size of the signature bitset.
+ * Also the width of Signature. Every ComponentTypeID below it is addressable.
+ */
+constexpr std::size_t MAX_COMPONENTS = ECS_MAX_COMPONENTS;
+
+/**
+ * @class BasicSignature
+ * @brief Fixed-width bit mask stored as 64-bit words
+ * @tparam Bits Number of bits, a multiple of 64
+ *
+ * Offers the subset of std::bitset used by the ECS, plus contains() and intersects()
+ * for matching. Every operation is a loop over a compile-time number of words with
+ * no early exit, which compilers unroll and vectorize (SSE2 handles 128 bits per
+ * instruction, AVX2 256), so wider masks cost little more than a single word.
  */
-const ComponentTypeID MAX_COMPONENTS = 64;
+template <std::size_t Bits>
+class BasicSignature {
+    static_assert(Bits > 0 && Bits % 64 == 0, "BasicSignature holds whole 64-bit words");
+
+public:
+    /** Number of 64-bit words */
+    static constexpr std::size_t WORDS = Bits / 64;
+
+    constexpr BasicSignature() = default;
+
+    /**
+     * @brief Creates a mask from the value of its lowest 64 bits, as std::bitset
+     * @param low Bits 0 to 63
+     */
+    constexpr BasicSignature(std::uint64_t low) : _words{low} {}
+
+    /** Number of bits */
+    static constexpr std::size_t size() { return Bits; }
+
+    constexpr bool test(std::size_t bit) const {
+        return (_words[bit / 64] >> (bit % 64)) & 1u;
+    }
+
+    constexpr bool operator[](std::size_t bit) const {
+        return test(bit);
+    }
+
+    constexpr BasicSignature &set(std::size_t bit, bool value = true) {
+        std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+        _words[bit / 64] = value ? (_words[bit / 64] | mask) : (_words[bit / 64] & ~mask);
+        return *this;
+    }
+
+    constexpr BasicSignature &reset(std::size_t bit) {
+        return set(bit, false);
+    }
+
+    constexpr BasicSignature &reset() {
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            _words[i] = 0;
+        }
+        return *this;
+    }
+
+    constexpr bool any() const {
+        std::uint64_t bits = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            bits |= _words[i];
+        }
+        return bits != 0;
+    }
+
+    constexpr bool none() const {
+        return !any();
+    }
+
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+            total += static_cast<std::size_t>(__builtin_popcountll(_words[i]));
+#else
+            for (std::uint64_t bits = _words[i]; bits != 0; bits &= bits - 1) {
+                ++total;
+            }
+#endif
+        }
+        return total;
+    }
+
+    /**
+     * @brief Checks whether every bit of another mask is set here
+     * @param required Mask to test, e.g. a system signature
+     * @return True if (*this & required) == required
+     */
+    constexpr bool contains(const BasicSignature &required) const {
+        std::uint64_t missing = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            missing |= required._words[i] & ~_words[i];
+        }
+        return missing == 0;
+    }
+
+    /**
+     * @brief Checks whether two masks share a bit
+     * @param other Mask to test
+     * @return True if (*this & other).any()
+     */
+    constexpr bool intersects(const BasicSignature &other) const {
+        std::uint64_t common = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            common |= _words[i] & other._words[i];
+        }
+        return common != 0;
+    }
+
+    /**
+     * @brief Gets one 64-bit word of the mask
+     * @param index Word index, below WORDS (bit b lives in word b / 64)
+     */
+    constexpr std::uint64_t word(std::size_t index) const {
+        return _words[index];
+    }
+
+    constexpr BasicSignature &operator&=(const BasicSignature &other) {
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            _words[i] &= other._words[i];
+        }
+        return *this;
+    }
+
+    constexpr BasicSignature &operator|=(const BasicSignature &other) {
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            _words[i] |= other._words[i];
+        }
+        return *this;
+    }
+
+    constexpr BasicSignature &operator^=(const BasicSignature &other) {
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            _words[i] ^= other._words[i];
+        }
+        return *this;
+    }
+
+    constexpr BasicSignature operator~() const {
+        BasicSignature result;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            result._words[i] = ~_words[i];
+        }
+        return result;
+    }
+
+    friend constexpr BasicSignature operator&(BasicSignature lhs, const BasicSignature &rhs) { return lhs &= rhs; }
+    friend constexpr BasicSignature operator|(BasicSignature lhs, const BasicSignature &rhs) { return lhs |= rhs; }
+    friend constexpr BasicSignature operator^(BasicSignature lhs, const BasicSignature &rhs) { return lhs ^= rhs; }
+
+    friend constexpr bool operator==(const BasicSignature &lhs, const BasicSignature &rhs) {
+        std::uint64_t different = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            different |= lhs._words[i] ^ rhs._words[i];
+        }
+        return different == 0;
+    }
+
+    friend constexpr bool operator!=(const BasicSignature &lhs, const BasicSignature &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * @brief Formats the mask as std::bitset does, highest bit first
+     * @return String of size() '0' / '1' characters
+     */
+    std::string to_string() const {
+        std::string text(Bits, '0');
+        for (std::size_t bit = 0; bit < Bits; ++bit) {
+            if (test(bit)) {
+                text[Bits - 1 - bit] = '1';
+            }
+        }
+        return text;
+    }
+
+private:
+    std::uint64_t _words[WORDS]{};
+};
+
+namespace std {
+/** FNV-style hash over the words, used by the archetype map */
+template <std::size_t Bits>
+struct hash<BasicSignature<Bits>> {
+    std::size_t operator()(const BasicSignature<Bits> &signature) const noexcept {
+        std::uint64_t value = 0xcbf29ce484222325ull;
+        for (std::size_t i = 0; i < BasicSignature<Bits>::WORDS; ++i) {
+            value = (value ^ signature.word(i)) * 0x100000001b3ull;
+        }
+        return static_cast<std::size_t>(value ^ (value >> 32));
+    }
+};
+} // namespace std
 
 /**
  * @typedef Signature
  * @brief Component signature for entities
  *
- * A bitset where each bit represents whether an entity has a specific component type.
+ * A bit mask where each bit represents whether an entity has a specific component type.
  * Used for efficient component membership testing and system-entity matching.
  */
-using Signature = std::bitset<MAX_COMPONENTS>;
+using Signature = BasicSignature<MAX_COMPONENTS>;
+
+
+/**
+ * @brief Calls a function for every set bit of a signature, in ascending order
+ * @param signature The signature to scan
+ * @param fn Callable taking the ComponentTypeID of each set bit
+ */
+template <typename Fn>
+inline void forEachSetBit(const Signature &signature, Fn &&fn)
+{
+    for (std::size_t word = 0; word < Signature::WORDS; ++word) {
+        std::uint64_t bits = signature.word(word);
+        while (bits != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+            unsigned index = static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+            unsigned index = 0;
+            while (((bits >> index) & 1u) == 0) {
+                ++index;
+            }
+#endif
+            fn(static_cast<ComponentTypeID>(word * 64 + index));
+            bits &= bits - 1;
+        }
+    }
+}
+
+/**
+ * @typedef Tick
+ * @brief Change-detection clock value (see Coordinator::advanceTick)
+ */
+using Tick = std::uint32_t;
+
+/**
+ * @enum StorageMode
+ * @brief Component storage backend used by a Coordinator
+ *
+ * - SparseSet: one packed sparse set per component type (default).
+ * - Archetype: entities with an identical Signature are grouped in fixed-size
+ *   chunks holding one column per component, for whole-group SoA iteration.
+ */
+enum class StorageMode : std::uint8_t {
+    SparseSet,
+    Archetype
+};
@@ -0,0 +1,363 @@
+/**
+ * @file View.hpp
+ * @brief Multi-component views iterating component storages directly
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "ComponentStorage.hpp"
+#include "Types.hpp"
+
+/**
+ * @struct Exclude
+ * @brief Tag listing component types an entity must NOT have to appear in a view
+ * @tparam Ts Excluded component types
+ */
+template <typename... Ts>
+struct Exclude {};
+
+/**
+ * @var exclude
+ * @brief Convenience instance of Exclude, e.g. `coordinator.view<A, B>(exclude<C>)`
+ */
+template <typename... Ts>
+inline constexpr Exclude<Ts...> exclude{};
+
+/**
+ * @struct Changed
+ * @brief View term: requires T and keeps the entities whose T changed since the view tick
+ * @tparam T Component type, whose storage must have change tracking enabled
+ */
+template <typename T>
+struct Changed {};
+
+/**
+ * @struct Added
+ * @brief View term: requires T and keeps the entities whose T was added since the view tick
+ * @tparam T Component type, whose storage must have change tracking enabled
+ */
+template <typename T>
+struct Added {};
+
+/**
+ * @struct ViewTerm
+ * @brief Describes a required view term: a plain component type, Changed<T> or Added<T>
+ */
+template <typename T>
+struct ViewTerm {
+    using Component = T;
+    static constexpr bool changed = false;
+    static constexpr bool added = false;
+};
+
+template <typename T>
+struct ViewTerm<Changed<T>> {
+    using Component = T;
+    static constexpr bool changed = true;
+    static constexpr bool added = false;
+};
+
+template <typename T>
+struct ViewTerm<Added<T>> {
+    using Component = T;
+    static constexpr bool changed = false;
+    static constexpr bool added = true;
+};
+
+/**
+ * @typedef ViewComponent
+ * @brief Component type behind a view term (T for T, Changed<T> and Added<T>)
+ */
+template <typename T>
+using ViewComponent = typename ViewTerm<T>::Component;
+
+template <typename Excluded, typename... Ts>
+class View;
+
+/**
+ * @class View
+ * @brief Iterates every entity owning all of Ts... and none of Us...
+ * @tparam Us Excluded component types
+ * @tparam Ts Required component types, optionally wrapped in Changed<> or Added<>
+ *
+ * The view walks the packed entity array of the smallest required storage and tests
+ * the other storages with a sparse lookup, so it neither scans every entity slot nor
+ * allocates. Dereferencing yields a `std::tuple<Entity, Ts&...>`, where a Changed<T>
+ * or Added<T> term yields a T& and a SoA component (see SoA.hpp) a SoARef<T>:
+ * @code
+ * for (auto [entity, position, velocity] : coordinator.view<Position, Velocity>()) { ... }
+ * for (auto [entity, transform] : coordinator.view<Changed<Transform>>()) { ... }
+ * @endcode
+ *
+ * Changed<T> and Added<T> keep only the entities whose T was changed or added at or
+ * after the tick the view was built with. When that tick is the current one, the view
+ * can pivot on the storage's change log (BasicComponentStorage::changeLog()) instead
+ * of its packed array, so iterating costs O(touched entries), not O(stored entries).
+ * For older ticks the log does not reach back far enough and the packed array is
+ * filtered by tick.
+ *
+ * Entities are visited from the back of the packed array, so removing a component
+ * from (or destroying) the entity currently visited is safe. Any other structural
+ * change during iteration invalidates the view.
+ */
+template <typename... Us, typename... Ts>
+class View<Exclude<Us...>, Ts...> {
+    static_assert(sizeof...(Ts) > 0, "A view needs at least one component type");
+
+    using Storages = std::tuple<BasicComponentStorage<ViewComponent<Ts>> *...>;
+    using Indices = std::index_sequence_for<Ts...>;
+
+    /** True if some term filters on ticks */
+    static constexpr bool filtered = ((ViewTerm<Ts>::changed || ViewTerm<Ts>::added) || ...);
+
+public:
+    /** Value yielded for every matching entity */
+    using value_type = std::tuple<Entity, ComponentRef<ViewComponent<Ts>>...>;
+
+    /**
+     * @class Iterator
+     * @brief Forward iterator over the matching entities of a view
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = View::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator(const View *view, std::size_t index) : _view(view), _index(index) {
+            skipUnmatched();
+        }
+
+        value_type operator*() const {
+            return _view->get(_view->pivotAt(_index - 1), Indices{});
+        }
+
+        Iterator &operator++() {
+            --_index;
+            skipUnmatched();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return _index == other._index; }
+        bool operator!=(const Iterator &other) const { return _index != other._index; }
+
+    private:
+        const View *_view;
+
+        /** One past the packed index of the current entity (0 means end) */
+        std::size_t _index;
+
+        void skipUnmatched() {
+            while (_index > 0 && !_view->accepts(_index - 1)) {
+                --_index;
+            }
+        }
+    };
+
+    /**
+     * @brief Builds a view over the given storages
+     * @param storages Storages of the required components (nullptr if unregistered)
+     * @param excluded Storages of the excluded components (nullptr if unregistered)
+     * @param since Oldest tick accepted by the Changed<> and Added<> terms
+     * @throws std::logic_error if a Changed<> or Added<> term targets a storage without change tracking
+     */
+    View(Storages storages, std::tuple<BasicComponentStorage<Us> *...> excluded, Tick since = 0)
+        : _storages(storages), _excluded(excluded), _since(since) {
+        bool complete = std::apply([](auto *...storage) { return ((storage != nullptr) && ...); }, _storages);
+        if (!complete) {
+            return;
+        }
+        checkTracking(Indices{});
+        _count = static_cast<std::size_t>(-1);
+        std::apply([this](auto *...storage) { (selectPivot(storage), ...); }, _storages);
+        if constexpr (filtered) {
+            selectLogPivot(Indices{});
+        }
+    }
+
+    Iterator begin() const { return Iterator(this, _count); }
+    Iterator end() const { return Iterator(this, 0); }
+
+    /**
+     * @brief Calls a function for every matching entity
+     * @param fn Callable taking (Entity, Ts&...), with SoARef<T> for SoA components
+     */
+    template <typename Fn>
+    void each(Fn &&fn) const {
+        if constexpr (sizeof...(Ts) == 1 && sizeof...(Us) == 0 && !filtered) {
+            // Single storage: every pivot entity matches, walk the packed arrays directly
+            auto *storage = std::get<0>(_storages);
+            if (!storage) {
+                return;
+            }
+            for (std::size_t i = _count; i > 0; --i) {
+                fn(_pivot[i - 1], storage->at(i - 1));
+            }
+        } else {
+            for (std::size_t i = _count; i > 0; --i) {
+                if (accepts(i - 1)) {
+                    std::apply(fn, get(pivotAt(i - 1), Indices{}));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the field columns of the only component of the view
+     * @return One span per field, parallel to the packed entity array (empty if the
+     *         component is not registered)
+     *
+     * Only for single-component, unfiltered views of a SoA component.
+     */
+    auto columns() const {
+        static_assert(sizeof...(Ts) == 1 && sizeof...(Us) == 0 && !filtered,
+                      "columns() needs a view over exactly one component, without filters");
+        using T = ViewComponent<std::tuple_element_t<0, std::tuple<Ts...>>>;
+        auto *storage = std::get<0>(_storages);
+        return storage ? storage->columns() : SoASpan<T>();
+    }
+
+    /**
+     * @brief Checks if an entity matches the view
+     * @param entity Entity to test
+     * @return True if the entity owns all required and none of the excluded components,
+     *         and passes every Changed<> and Added<> term
+     */
+    bool contains(Entity entity) const {
+        return matches(entity, Indices{}) && !(hasExcluded<Us>(entity) || ...);
+    }
+
+    /**
+     * @brief Gets an upper bound of the number of matching entities
+     * @return Size of the smallest required storage, or of the change log pivoted on
+     */
+    std::size_t sizeHint() const {
+        return _count;
+    }
+
+private:
+    Storages _storages;
+    std::tuple<BasicComponentStorage<Us> *...> _excluded;
+
+    /** Oldest tick accepted by the Changed<> and Added<> terms */
+    Tick _since = 0;
+
+    /** Packed entity array of the smallest required storage */
+    const Entity *_pivot = nullptr;
+
+    /** Number of entities in the pivot array */
+    std::size_t _count = 0;
+
+    /** Change log pivoted on instead of _pivot (read through the vector: it may grow) */
+    const std::pmr::vector<Entity> *_log = nullptr;
+
+    /** Index of the Changed<> / Added<> term owning _log */
+    std::size_t _logTerm = 0;
+
+    template <typename S>
+    void selectPivot(S *storage) {
+        if (storage->size() < _count) {
+            _count = storage->size();
+            _pivot = storage->entities();
+        }
+    }
+
+    template <std::size_t... Is>
+    void selectLogPivot(std::index_sequence<Is...>) {
+        (selectLogPivot<Ts, Is>(), ...);
+    }
+
+    template <typename T, std::size_t I>
+    void selectLogPivot() {
+        if constexpr (ViewTerm<T>::changed || ViewTerm<T>::added) {
+            const auto *log = std::get<I>(_storages)->changeLog(ViewTerm<T>::added, _since);
+            if (log && log->size() < _count) {
+                _count = log->size();
+                _log = log;
+                _logTerm = I;
+            }
+        }
+    }
+
+    /** Entity at a pivot position */
+    Entity pivotAt(std::size_t index) const {
+        if constexpr (filtered) {
+            if (_log) {
+                return (*_log)[index];
+            }
+        }
+        return _pivot[index];
+    }
+
+    /** True if the entity at a pivot position matches (and is the live entry of a log) */
+    bool accepts(std::size_t index) const {
+        Entity entity = pivotAt(index);
+        if constexpr (filtered) {
+            if (_log && !liveEntry(entity, index, Indices{})) {
+                return false;
+            }
+        }
+        return contains(entity);
+    }
+
+    template <std::size_t... Is>
+    bool liveEntry(Entity entity, std::size_t index, std::index_sequence<Is...>) const {
+        return ((Is != _logTerm || loggedIn<Ts>(std::get<Is>(_storages), entity, index)) && ...);
+    }
+
+    template <typename T, typename S>
+    bool loggedIn(S *storage, Entity entity, std::size_t index) const {
+        if constexpr (ViewTerm<T>::changed || ViewTerm<T>::added) {
+            return storage->loggedAt(entity, index, ViewTerm<T>::added);
+        } else {
+            return true;
+        }
+    }
+
+    template <std::size_t... Is>
+    void checkTracking(std::index_sequence<Is...>) const {
+        bool tracked = ((!(ViewTerm<Ts>::changed || ViewTerm<Ts>::added) ||
+                         std::get<Is>(_storages)->isChangeTracked()) && ...);
+        if (!tracked) {
+            throw std::logic_error("View: Changed<> and Added<> require change tracking on the storage.");
+        }
+    }
+
+    template <std::size_t... Is>
+    value_type get(Entity entity, std::index_sequence<Is...>) const {
+        return value_type(entity, std::get<Is>(_storages)->getDataUnchecked(entity)...);
+    }
+
+    template <std::size_t... Is>
+    bool matches(Entity entity, std::index_sequence<Is...>) const {
+        return (term<Ts>(std::get<Is>(_storages), entity) && ...);
+    }
+
+    template <typename T, typename S>
+    bool term(S *storage, Entity entity) const {
+        if (!storage->hasData(entity)) {
+            return false;
+        }
+        if constexpr (ViewTerm<T>::changed) {
+            return storage->changedTick(entity) >= _since;
+        } else if constexpr (ViewTerm<T>::added) {
+            return storage->addedTick(entity) >= _since;
+        } else {
+            return true;
+        }
+    }
+
+    template <typename U>
+    bool hasExcluded(Entity entity) const {
+        auto *storage = std::get<BasicComponentStorage<U> *>(_excluded);
+        return storage != nullptr && storage->hasData(entity);
+    }
+};
@@ -0,0 +1,348 @@
+/**
+ * @file World.hpp
+ * @brief Fixed-schema ECS world with compile-time component dispatch
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ComponentStorage.hpp"
+#include "EntityManager.hpp"
+#include "Span.hpp"
+#include "Types.hpp"
+#include "View.hpp"
+
+/**
+ * @struct WorldTypeIndex
+ * @brief Position of T inside the list Us..., as a compile-time constant
+ */
+template <typename T, typename... Us>
+struct WorldTypeIndex;
+
+template <typename T, typename... Us>
+struct WorldTypeIndex<T, T, Us...> : std::integral_constant<std::size_t, 0> {};
+
+template <typename T, typename U, typename... Us>
+struct WorldTypeIndex<T, U, Us...> : std::integral_constant<std::size_t, 1 + WorldTypeIndex<T, Us...>::value> {};
+
+/**
+ * @class World
+ * @brief Alternative to Coordinator for schemas known at compile time
+ * @tparam Cs Every component type of the world
+ *
+ * Storages are held by value in a std::tuple of BasicComponentStorage, and a
+ * component type ID is the position of the type in Cs..., so every call resolves
+ * at compile time: no virtual call, no AComponentStorage vtable and no map lookup.
+ * System loops written with each() or view() are plain loops over packed arrays the
+ * compiler can inline and vectorize.
+ *
+ * A World takes no lock: synchronize externally if several threads modify it. The
+ * dynamic Coordinator remains available for systems, scheduling and tools.
+ *
+ * @code
+ * World<Position, Velocity> world;
+ * Entity entity = world.createEntity();
+ * world.addComponent(entity, Position{});
+ * world.each<Position, Velocity>([](Entity, Position &p, Velocity &v) { p.x += v.x; });
+ * @endcode
+ */
+template <typename... Cs>
+class World {
+    static_assert(sizeof...(Cs) <= MAX_COMPONENTS, "Too many component types for a Signature");
+
+public:
+    /**
+     * @brief Gets the component type ID of a component type of the world
+     * @tparam T Component type, one of Cs...
+     * @return Position of T in Cs...
+     */
+    template <typename T>
+    static constexpr ComponentTypeID typeId() {
+        return static_cast<ComponentTypeID>(WorldTypeIndex<T, Cs...>::value);
+    }
+
+    /**
+     * @brief Gets the signature made of a set of component types
+     * @tparam Ts Component types, each one of Cs...
+     * @return Signature with the bit of every type of Ts... set
+     */
+    template <typename... Ts>
+    static constexpr Signature signatureOf() {
+        Signature signature;
+        (signature.set(typeId<Ts>()), ...);
+        return signature;
+    }
+
+    /**
+     * @brief Creates a world
+     * @param maxEntities Maximum number of living entities
+     */
+    explicit World(Entity maxEntities = MAX_ENTITIES) : _entities(maxEntities) {}
+
+    /**
+     * @brief Creates a new entity
+     * @return The new entity handle
+     */
+    Entity createEntity() {
+        return _entities.createEntity();
+    }
+
+    /**
+     * @brief Destroys an entity and all its components
+     * @param entity Entity to destroy (stale handles are ignored)
+     */
+    void destroyEntity(Entity entity) {
+        if (!_entities.entityExists(entity)) {
+            return;
+        }
+        Signature signature = _entities.getSignature(entity);
+        (removeIfSet<Cs>(entity, signature), ...);
+        _entities.destroyEntity(entity);
+    }
+
+    /**
+     * @brief Checks if an entity exists
+     * @param entity Entity handle
+     * @return True if the handle refers to a living entity
+     */
+    bool entityExists(Entity entity) {
+        return _entities.entityExists(entity);
+    }
+
+    /**
+     * @brief Adds a component to an entity
+     * @tparam T Component type
+     * @param entity Entity to add the component to (stale handles are ignored)
+     * @param component Component instance to add
+     *
+     * If the entity already owns a component of this type, the existing data is kept.
+     */
+    template <typename T>
+    void addComponent(Entity entity, T component) {
+        if (!_entities.entityExists(entity)) {
+            return;
+        }
+        storage<T>().insertData(entity, std::move(component));
+        _entities.setSignature(entity, _entities.getSignature(entity) | signatureOf<T>());
+    }
+
+    /**
+     * @brief Constructs a component of an entity in place
+     * @tparam T Component type
+     * @param entity Entity to add the component to
+     * @param args Arguments forwarded to the constructor of T (brace-initialization for aggregates)
+     * @return Reference to the new component, or to the existing one if the entity already owns a T
+     * @throws std::out_of_range if the entity does not exist
+     */
+    template <typename T, typename... Args>
+    ComponentRef<T> emplaceComponent(Entity entity, Args &&...args) {
+        if (!_entities.entityExists(entity)) {
+            throw std::out_of_range("World::emplaceComponent: entity does not exist.");
+        }
+        ComponentRef<T> component = storage<T>().emplaceData(entity, std::forward<Args>(args)...);
+        _entities.setSignature(entity, _entities.getSignature(entity) | signatureOf<T>());
+        return component;
+    }
+
+    /**
+     * @brief Removes a component from an entity
+     * @tparam T Component type
+     * @param entity Entity to remove the component from
+     */
+    template <typename T>
+    void removeComponent(Entity entity) {
+        if (!_entities.entityExists(entity)) {
+            return;
+        }
+        storage<T>().removeData(entity);
+        _entities.setSignature(entity, _entities.getSignature(entity) & ~signatureOf<T>());
+    }
+
+    /**
+     * @brief Gets a reference to a component
+     * @tparam T Component type
+     * @param entity Entity owning the component
+     * @return Reference to the component (a SoARef for SoA components)
+     * @throws std::out_of_range if the entity has no such component
+     */
+    template <typename T>
+    ComponentRef<T> getComponent(Entity entity) {
+        return storage<T>().getData(entity);
+    }
+
+    /**
+     * @brief Gets a reference to a component the caller is about to modify
+     * @tparam T Component type
+     * @param entity Entity owning the component
+     * @return Reference to the component, marked as changed at the current tick
+     * @throws std::out_of_range if the entity has no such component
+     */
+    template <typename T>
+    ComponentRef<T> getComponentMut(Entity entity) {
+        return storage<T>().getDataMut(entity);
+    }
+
+    /**
+     * @brief Marks the component of an entity as changed at the current tick
+     * @tparam T Component type
+     * @param entity Entity owning the component (ignored if it has none)
+     */
+    template <typename T>
+    void markDirty(Entity entity) {
+        storage<T>().markChanged(entity);
+    }
+
+    /**
+     * @brief Enables per-entity added/changed ticks on the storage of a component type
+     * @tparam T Component type, required by the Changed<T> and Added<T> view terms
+     */
+    template <typename T>
+    void enableChangeTracking() {
+        storage<T>().setChangeTracking(true);
+    }
+
+    /**
+     * @brief Starts a new change-detection tick
+     * @return The new current tick
+     */
+    Tick advanceTick() {
+        ++_tick;
+        std::apply([this](auto &...storages) { (storages.setCurrentTick(_tick), ...); }, _storages);
+        return _tick;
+    }
+
+    /**
+     * @brief Gets the current change-detection tick
+     * @return Tick stamped on additions and changes
+     */
+    Tick getCurrentTick() const {
+        return _tick;
+    }
+
+    /**
+     * @brief Gets a component if the entity owns one
+     * @tparam T Component type
+     * @param entity Entity to get the component from
+     * @return Pointer to the component (a SoAPtr for SoA components), or nullptr
+     */
+    template <typename T>
+    ComponentPtr<T> tryGetComponent(Entity entity) {
+        auto &components = storage<T>();
+        if (!components.hasData(entity)) {
+            return nullptr;
+        }
+        return componentAddress<T>(components.getDataUnchecked(entity));
+    }
+
+    /**
+     * @brief Gets the field columns of a SoA component type
+     * @tparam T Component type declaring a SoALayout
+     * @return One span per field, parallel to the packed entity array, valid until the
+     *         next structural change of T
+     */
+    template <typename T>
+    SoASpan<T> columns() {
+        return storage<T>().columns();
+    }
+
+    /**
+     * @brief Checks if an entity has a component
+     * @tparam T Component type
+     * @param entity Entity to check
+     * @return True if the entity owns a T
+     */
+    template <typename T>
+    bool hasComponent(Entity entity) const {
+        return storage<T>().hasData(entity);
+    }
+
+    /**
+     * @brief Gets the component signature of an entity
+     * @param entity Entity handle
+     * @return Signature of the entity (empty for stale handles)
+     */
+    Signature getEntitySignature(Entity entity) {
+        return _entities.getSignature(entity);
+    }
+
+    /**
+     * @brief Gets every living entity
+     * @return Non-owning view of the living entities, valid until the next creation or destruction
+     */
+    Span<const Entity> getEntities() const {
+        return _entities.getEntities();
+    }
+
+    /**
+     * @brief Gets the storage of a component type
+     * @tparam T Component type
+     * @return Reference to the storage, for direct access to its packed arrays
+     */
+    template <typename T>
+    BasicComponentStorage<T> &storage() {
+        return std::get<WorldTypeIndex<T, Cs...>::value>(_storages);
+    }
+
+    /**
+     * @brief Gets the storage of a component type
+     * @tparam T Component type
+     * @return Const reference to the storage
+     */
+    template <typename T>
+    const BasicComponentStorage<T> &storage() const {
+        return std::get<WorldTypeIndex<T, Cs...>::value>(_storages);
+    }
+
+    /**
+     * @brief Builds a view over every entity owning all of Ts... and none of Us...
+     * @tparam Ts Required component types, optionally wrapped in Changed<> or Added<>
+     * @tparam Us Excluded component types
+     * @return View yielding (Entity, Ts&...) tuples, see View
+     *
+     * Changed<T> / Added<T> terms keep the entries of the current tick (see viewSince()).
+     */
+    template <typename... Ts, typename... Us>
+    View<Exclude<Us...>, Ts...> view(Exclude<Us...> excluded = {}) {
+        return viewSince<Ts...>(_tick, excluded);
+    }
+
+    /**
+     * @brief Builds a view whose Changed<> / Added<> terms accept every tick since a given one
+     * @tparam Ts Required component types, optionally wrapped in Changed<> or Added<>
+     * @tparam Us Excluded component types
+     * @param since Oldest accepted tick
+     * @return View yielding (Entity, Ts&...) tuples, see View
+     */
+    template <typename... Ts, typename... Us>
+    View<Exclude<Us...>, Ts...> viewSince(Tick since, Exclude<Us...> = {}) {
+        return View<Exclude<Us...>, Ts...>(std::make_tuple(&storage<ViewComponent<Ts>>()...),
+                                           std::make_tuple(&storage<Us>()...), since);
+    }
+
+    /**
+     * @brief Calls a function for every entity owning all of Ts...
+     * @tparam Ts Required component types
+     * @param fn Callable taking (Entity, Ts&...)
+     */
+    template <typename... Ts, typename Fn>
+    void each(Fn &&fn) {
+        view<Ts...>().each(std::forward<Fn>(fn));
+    }
+
+private:
+    EntityManager _entities;
+    std::tuple<BasicComponentStorage<Cs>...> _storages;
+    Tick _tick = 1;
+
+    template <typename T>
+    void removeIfSet(Entity entity, const Signature &signature) {
+        if (signature.test(typeId<T>())) {
+            storage<T>().removeData(entity);
+        }
+    }
+};
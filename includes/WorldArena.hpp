@@ -0,0 +1,74 @@
+/**
+ * @file WorldArena.hpp
+ * @brief Per-world arena backing the containers of a Coordinator
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @class WorldArena
+ * @brief Monotonic arena with a pool on top, to back a whole world
+ *
+ * The arena reserves one contiguous buffer up front (growing with extra blocks only
+ * if it runs out). A pool resource sits on top of it, so containers that grow or
+ * shrink recycle their freed blocks instead of consuming the buffer. release()
+ * drops everything at once, without visiting any allocation.
+ *
+ * The pool is synchronized: besides structural changes, which hold the Coordinator
+ * mutex exclusively, change tracking appends to per-storage logs under the shared
+ * lock or during a parallel phase, so several threads may allocate at once.
+ *
+ * Only the containers listed at CoordinatorConfig::memoryResource use the arena; in
+ * archetype storage mode, chunks and archetype bookkeeping keep using the global
+ * allocator.
+ *
+ * @code
+ * WorldArena arena(64 * 1024 * 1024);
+ * CoordinatorConfig config;
+ * config.memoryResource = arena.resource();
+ * coordinator.init(config);
+ * // ... end of the match
+ * coordinator.shutdown();
+ * arena.release();
+ * @endcode
+ */
+class WorldArena {
+public:
+    /**
+     * @brief Creates an arena
+     * @param initialSize Size in bytes of the up-front buffer
+     * @param upstream Resource the buffer (and any extra block) is taken from
+     */
+    explicit WorldArena(std::size_t initialSize = 16 * 1024 * 1024,
+                        std::pmr::memory_resource *upstream = std::pmr::get_default_resource())
+        : _monotonic(initialSize, upstream), _pool(&_monotonic) {}
+
+    WorldArena(const WorldArena &) = delete;
+    WorldArena &operator=(const WorldArena &) = delete;
+
+    /**
+     * @brief Gets the resource to hand to CoordinatorConfig::memoryResource
+     * @return The pool resource of the arena
+     */
+    std::pmr::memory_resource *resource() {
+        return &_pool;
+    }
+
+    /**
+     * @brief Frees every allocation made from the arena at once
+     *
+     * Every container using the arena must have been destroyed first (see
+     * Coordinator::shutdown()). The arena can be used again afterwards.
+     */
+    void release() {
+        _pool.release();
+        _monotonic.release();
+    }
+
+private:
+    std::pmr::monotonic_buffer_resource _monotonic;
+    std::pmr::synchronized_pool_resource _pool;
+};
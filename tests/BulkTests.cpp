@@ -0,0 +1,161 @@
+/**
+ * @file BulkTests.cpp
+ * @brief Batched entity creation/destruction, addComponents() and spawn()
+ */
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct MovementSystem : System {};
+
+/** Initializes a world with a MovementSystem over Position + Velocity */
+std::shared_ptr<MovementSystem> makeWorld(Coordinator &coordinator, StorageMode mode, Entity capacity = MAX_ENTITIES) {
+    coordinator.init({mode, capacity});
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    auto system = coordinator.registerSystem<MovementSystem>();
+    Signature signature;
+    signature.set(coordinator.getComponentTypeID<Position>());
+    signature.set(coordinator.getComponentTypeID<Velocity>());
+    coordinator.setSystemSignature<MovementSystem>(signature);
+    return system;
+}
+
+/** createEntities() returns distinct living handles */
+void testCreateEntities() {
+    Coordinator coordinator;
+    makeWorld(coordinator, StorageMode::SparseSet);
+    Entity freed = coordinator.createEntity();
+    coordinator.destroyEntity(freed);
+
+    std::vector<Entity> entities = coordinator.createEntities(100);
+    CHECK(entities.size() == 100);
+    CHECK(std::set<Entity>(entities.begin(), entities.end()).size() == 100);
+    for (Entity entity : entities) {
+        CHECK(coordinator.entityExists(entity));
+    }
+    CHECK(coordinator.getLivingEntityCount() == 100);
+}
+
+/** Exceeding the capacity throws before any entity of the batch is created */
+void testCapacityIsCheckedBeforeCreating() {
+    Coordinator coordinator;
+    makeWorld(coordinator, StorageMode::SparseSet, 10);
+    coordinator.createEntities(8);
+
+    bool threw = false;
+    try {
+        coordinator.createEntities(5);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(coordinator.getLivingEntityCount() == 8);
+
+    threw = false;
+    try {
+        coordinator.spawn(3, Position{0.0f, 0.0f});
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(coordinator.getLivingEntityCount() == 8);
+
+    // The remaining room can still be filled
+    CHECK(coordinator.createEntities(2).size() == 2);
+    CHECK(coordinator.getLivingEntityCount() == 10);
+}
+
+/** addComponents() stores each value and updates system membership */
+void testAddComponents(StorageMode mode) {
+    Coordinator coordinator;
+    auto system = makeWorld(coordinator, mode);
+    std::vector<Entity> entities = coordinator.createEntities(50);
+    std::vector<Position> positions;
+    std::vector<Velocity> velocities(50, Velocity{1.0f, 0.0f});
+    for (int i = 0; i < 50; ++i) {
+        positions.push_back(Position{static_cast<float>(i), 0.0f});
+    }
+    coordinator.addComponents<Position>(entities, positions);
+    CHECK(system->entities.size() == 0);
+    coordinator.addComponents<Velocity>(entities, velocities);
+    CHECK(system->entities.size() == 50);
+    for (int i = 0; i < 50; ++i) {
+        CHECK(coordinator.getComponent<Position>(entities[i]).x == static_cast<float>(i));
+        CHECK(system->entities.contains(entities[i]));
+    }
+
+    bool threw = false;
+    try {
+        coordinator.addComponents<Position>(entities, Span<const Position>(positions.data(), 10));
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+/** destroyEntities() removes components and system membership, ignoring stale handles */
+void testDestroyEntities(StorageMode mode) {
+    Coordinator coordinator;
+    auto system = makeWorld(coordinator, mode);
+    std::vector<Entity> entities = coordinator.spawn(20, Position{0.0f, 0.0f}, Velocity{1.0f, 1.0f});
+    CHECK(system->entities.size() == 20);
+
+    Entity stale = entities[0];
+    coordinator.destroyEntity(stale);
+    std::vector<Entity> batch(entities.begin(), entities.begin() + 10);
+    coordinator.destroyEntities(batch);
+    CHECK(coordinator.getLivingEntityCount() == 10);
+    CHECK(system->entities.size() == 10);
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        CHECK(coordinator.entityExists(entities[i]) == (i >= 10));
+        CHECK(system->entities.contains(entities[i]) == (i >= 10));
+    }
+    CHECK(coordinator.getAllEntitiesWith<Position>().size() == 10);
+}
+
+/** spawn() fills components and systems, immediately or at flush time when async */
+void testSpawn(StorageMode mode, bool async) {
+    Coordinator coordinator;
+    auto system = makeWorld(coordinator, mode);
+    coordinator.setAsyncModifications(async);
+    std::vector<Entity> entities = coordinator.spawn(30, Position{1.0f, 2.0f}, Velocity{3.0f, 4.0f});
+    CHECK(entities.size() == 30);
+    CHECK(coordinator.getLivingEntityCount() == 30);
+    CHECK(system->entities.size() == (async ? 0u : 30u));
+
+    coordinator.flushCommands();
+    CHECK(system->entities.size() == 30);
+    for (Entity entity : entities) {
+        CHECK(coordinator.getComponent<Position>(entity).y == 2.0f);
+        CHECK(coordinator.getComponent<Velocity>(entity).x == 3.0f);
+    }
+}
+
+} // namespace
+
+int main() {
+    testCreateEntities();
+    testCapacityIsCheckedBeforeCreating();
+    for (StorageMode mode : {StorageMode::SparseSet, StorageMode::Archetype}) {
+        testAddComponents(mode);
+        testDestroyEntities(mode);
+        testSpawn(mode, false);
+        testSpawn(mode, true);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file ChangeTrackingTests.cpp
+ * @brief Changed<T> / Added<T> views and the per-tick change logs behind them
+ */
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x;
+};
+
+struct Velocity {
+    float v;
+};
+
+std::size_t countChanged(Coordinator &coordinator) {
+    std::size_t count = 0;
+    coordinator.view<Changed<Position>>().each([&](Entity, Position &) { ++count; });
+    return count;
+}
+
+/** A Changed<> view of the current tick only visits the touched entries, once each */
+void testChangedViewWalksTouchedEntries() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.enableChangeTracking<Position>();
+    std::vector<Entity> entities = coordinator.spawn(4000, Position{0.0f});
+    coordinator.advanceTick();
+
+    CHECK(coordinator.view<Changed<Position>>().sizeHint() == 0);
+    coordinator.getComponentMut<Position>(entities[10]).x = 1.0f;
+    coordinator.getComponentMut<Position>(entities[10]).x = 2.0f;
+    coordinator.markDirty<Position>(entities[20]);
+    coordinator.patchComponent<Position>(entities[30], [](Position &position) { position.x = 3.0f; });
+    CHECK(coordinator.view<Changed<Position>>().sizeHint() == 3);
+    CHECK(countChanged(coordinator) == 3);
+
+    coordinator.advanceTick();
+    CHECK(countChanged(coordinator) == 0);
+    std::size_t since = 0;
+    coordinator.viewSince<Changed<Position>>(coordinator.getCurrentTick() - 1).each([&](Entity, Position &) { ++since; });
+    CHECK(since == 3);
+}
+
+/** Stale log entries (removed, or re-added later in the tick) are skipped */
+void testStaleEntriesAreSkipped() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.enableChangeTracking<Position>();
+    std::vector<Entity> entities = coordinator.spawn(100, Position{0.0f});
+    coordinator.advanceTick();
+
+    coordinator.markDirty<Position>(entities[1]);
+    coordinator.markDirty<Position>(entities[2]);
+    coordinator.removeComponent<Position>(entities[1]);
+    coordinator.removeComponent<Position>(entities[3]);
+    coordinator.addComponent(entities[3], Position{5.0f});
+    coordinator.removeComponent<Position>(entities[3]);
+    coordinator.addComponent(entities[3], Position{6.0f});
+    CHECK(countChanged(coordinator) == 2);
+
+    std::size_t added = 0;
+    for (auto [entity, position] : coordinator.view<Added<Position>>()) {
+        CHECK(entity == entities[3] && position.x == 6.0f);
+        ++added;
+    }
+    CHECK(added == 1);
+}
+
+/** Changing other entities while iterating the log neither crashes nor revisits */
+void testChangesDuringIteration() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.enableChangeTracking<Position>();
+    std::vector<Entity> entities = coordinator.spawn(4096, Position{0.0f});
+    coordinator.advanceTick();
+
+    coordinator.markDirty<Position>(entities[0]);
+    std::size_t visited = 0;
+    coordinator.view<Changed<Position>>().each([&](Entity, Position &) {
+        for (std::size_t i = 1; i < entities.size(); ++i) {
+            coordinator.markDirty<Position>(entities[i]);
+        }
+        ++visited;
+    });
+    CHECK(visited == 1);
+    CHECK(countChanged(coordinator) == entities.size());
+}
+
+/** Owning groups reorder the storage without losing logged entries */
+void testGroupReorderKeepsLogs() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.enableChangeTracking<Position>();
+    std::vector<Entity> entities = coordinator.spawn(100, Position{0.0f});
+    auto group = coordinator.group<Position, Velocity>();
+    coordinator.advanceTick();
+
+    coordinator.markDirty<Position>(entities[50]);
+    coordinator.addComponent(entities[50], Velocity{1.0f});
+    coordinator.addComponent(entities[70], Velocity{1.0f});
+    CHECK(group.size() == 2);
+    std::size_t count = 0;
+    coordinator.view<Changed<Position>>().each([&](Entity entity, Position &) {
+        CHECK(entity == entities[50]);
+        ++count;
+    });
+    CHECK(count == 1);
+}
+
+} // namespace
+
+int main() {
+    testChangedViewWalksTouchedEntries();
+    testStaleEntriesAreSkipped();
+    testChangesDuringIteration();
+    testGroupReorderKeepsLogs();
+    return 0;
+}
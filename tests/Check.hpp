@@ -0,0 +1,22 @@
+/**
+ * @file Check.hpp
+ * @brief Minimal assertion helper shared by the test executables
+ */
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @def CHECK
+ * @brief Aborts the test with the failing expression and its location
+ *
+ * Variadic so that expressions with template argument lists need no extra parentheses.
+ */
+#define CHECK(...)                                                                         \
+    do {                                                                                   \
+        if (!(__VA_ARGS__)) {                                                              \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #__VA_ARGS__); \
+            std::abort();                                                                  \
+        }                                                                                  \
+    } while (0)
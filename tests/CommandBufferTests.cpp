@@ -0,0 +1,120 @@
+/**
+ * @file CommandBufferTests.cpp
+ * @brief Deferred and immediate structural changes
+ */
+#include <memory>
+#include <stdexcept>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+/** Component that can only be moved */
+struct MoveOnly {
+    std::unique_ptr<int> value;
+};
+
+/** Move-only components are added by rvalue, immediately and deferred */
+void testAddMoveOnlyComponent() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<MoveOnly>();
+
+    Entity immediate = coordinator.createEntity();
+    coordinator.addComponent(immediate, MoveOnly{std::make_unique<int>(3)});
+    CHECK(*coordinator.getComponent<MoveOnly>(immediate).value == 3);
+
+    coordinator.setAsyncModifications(true);
+    Entity deferred = coordinator.createEntity();
+    coordinator.addComponent(deferred, MoveOnly{std::make_unique<int>(4)});
+    CHECK(!coordinator.hasComponent<MoveOnly>(deferred));
+    CHECK(coordinator.getEnqueuedCommandsCount() == 1);
+    coordinator.flushCommands();
+    CHECK(*coordinator.getComponent<MoveOnly>(deferred).value == 4);
+}
+
+/** Deferred commands are coalesced: an add followed by a remove leaves nothing */
+void testAddThenRemoveCoalesces() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<MoveOnly>();
+    coordinator.setAsyncModifications(true);
+
+    Entity entity = coordinator.createEntity();
+    coordinator.addComponent(entity, MoveOnly{std::make_unique<int>(5)});
+    coordinator.removeComponent<MoveOnly>(entity);
+    coordinator.flushCommands();
+    CHECK(!coordinator.hasComponent<MoveOnly>(entity));
+}
+
+struct Position {
+    float x, y;
+};
+
+/** When set, moving a Fragile throws */
+bool gFailMoves = false;
+
+/** Component whose move constructor throws on demand */
+struct Fragile {
+    int value = 0;
+
+    Fragile() = default;
+    explicit Fragile(int v) : value(v) {}
+    Fragile(Fragile &&other) : value(other.value) {
+        if (gFailMoves) {
+            throw std::runtime_error("Fragile: move failed");
+        }
+    }
+    Fragile &operator=(Fragile &&other) = default;
+};
+
+/** A throwing command keeps the applied ones (and their events) and queues the rest again */
+void testThrowingCommandKeepsTheRest() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Fragile>();
+    int added = 0;
+    coordinator.onAdd<Position>([&added](Entity, Position &) { ++added; });
+    coordinator.setAsyncModifications(true);
+
+    Entity before = coordinator.createEntity();
+    Entity failing = coordinator.createEntity();
+    Entity after = coordinator.createEntity();
+    coordinator.addComponent(before, Position{1.0f, 0.0f});
+    coordinator.addComponent(failing, Fragile{7});
+    coordinator.addComponent(after, Position{3.0f, 0.0f});
+
+    gFailMoves = true;
+    bool threw = false;
+    try {
+        coordinator.flushCommands();
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    gFailMoves = false;
+    CHECK(threw);
+    CHECK(coordinator.hasComponent<Position>(before));
+    CHECK(added == 1);
+    CHECK(!coordinator.hasComponent<Fragile>(failing));
+    CHECK(!coordinator.hasComponent<Position>(after));
+    CHECK(coordinator.getEnqueuedCommandsCount() == 1);
+
+    coordinator.addComponent(failing, Position{2.0f, 0.0f});
+    coordinator.flushCommands();
+    CHECK(coordinator.getComponent<Position>(after).x == 3.0f);
+    CHECK(coordinator.getComponent<Position>(failing).x == 2.0f);
+    CHECK(added == 3);
+    CHECK(coordinator.getEnqueuedCommandsCount() == 0);
+}
+
+} // namespace
+
+int main() {
+    testAddMoveOnlyComponent();
+    testAddThenRemoveCoalesces();
+    testThrowingCommandKeepsTheRest();
+    return 0;
+}
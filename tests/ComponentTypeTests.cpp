@@ -0,0 +1,48 @@
+/**
+ * @file ComponentTypeTests.cpp
+ * @brief Component type IDs of qualified and reference types
+ */
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+/** const, volatile and references name the same component as the plain type */
+void testQualifiersShareTheId() {
+    ComponentTypeID position = ComponentType::id<Position>();
+    CHECK(ComponentType::id<const Position>() == position);
+    CHECK(ComponentType::id<volatile Position>() == position);
+    CHECK(ComponentType::id<Position &>() == position);
+    CHECK(ComponentType::id<const Position &>() == position);
+    CHECK(ComponentType::id<Position &&>() == position);
+    CHECK(ComponentType::id<Velocity>() != position);
+}
+
+/** Lookups through a const type find the component registered under the plain type */
+void testConstLookup() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    Entity entity = coordinator.createEntity();
+    coordinator.addComponent(entity, Position{1.0f, 2.0f});
+    CHECK(coordinator.getComponentTypeID<const Position>() == coordinator.getComponentTypeID<Position>());
+    CHECK(coordinator.hasComponent<const Position>(entity));
+}
+
+} // namespace
+
+int main() {
+    testQualifiersShareTheId();
+    testConstLookup();
+    return 0;
+}
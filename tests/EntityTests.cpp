@@ -0,0 +1,100 @@
+/**
+ * @file EntityTests.cpp
+ * @brief Generational entity handles: stale handles after slot reuse and free-list order
+ */
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+/** A recycled slot gets a bumped generation, and the old handle no longer exists */
+void testSlotReuseBumpsGeneration() {
+    EntityManager manager(64);
+    Entity first = manager.createEntity();
+    manager.destroyEntity(first);
+    Entity second = manager.createEntity();
+    CHECK(entityIndex(second) == entityIndex(first));
+    CHECK(entityGeneration(second) == entityGeneration(first) + 1);
+    CHECK(second != first);
+    CHECK(!manager.entityExists(first));
+    CHECK(manager.entityExists(second));
+
+    // Destroying the stale handle leaves the new occupant alone
+    manager.destroyEntity(first);
+    CHECK(manager.entityExists(second));
+    CHECK(manager.getLivingEntityCount() == 1);
+}
+
+/** The most recently freed slot is reused first */
+void testFreeListIsLifo() {
+    EntityManager manager(64);
+    std::vector<Entity> entities;
+    for (int i = 0; i < 5; ++i) {
+        entities.push_back(manager.createEntity());
+    }
+    manager.destroyEntity(entities[1]);
+    manager.destroyEntity(entities[3]);
+    manager.destroyEntity(entities[0]);
+
+    CHECK(entityIndex(manager.createEntity()) == entityIndex(entities[0]));
+    CHECK(entityIndex(manager.createEntity()) == entityIndex(entities[3]));
+    CHECK(entityIndex(manager.createEntity()) == entityIndex(entities[1]));
+    // Free list exhausted: fresh slots follow
+    CHECK(entityIndex(manager.createEntity()) == 5);
+}
+
+/** Coordinator calls through a stale handle do not reach the entity now in its slot */
+void testStaleHandlesAreIgnored() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+
+    Entity stale = coordinator.createEntity();
+    coordinator.addComponent(stale, Position{1.0f, 1.0f});
+    coordinator.destroyEntity(stale);
+    Entity current = coordinator.createEntity();
+    CHECK(entityIndex(current) == entityIndex(stale));
+    CHECK(!coordinator.entityExists(stale));
+    CHECK(!coordinator.hasComponent<Position>(current));
+
+    coordinator.addComponent(stale, Position{2.0f, 2.0f});
+    CHECK(!coordinator.hasComponent<Position>(current));
+    CHECK(!coordinator.hasComponent<Position>(stale));
+    CHECK(coordinator.tryGetComponent<Position>(stale) == nullptr);
+
+    coordinator.addComponent(current, Position{3.0f, 3.0f});
+    coordinator.removeComponent<Position>(stale);
+    CHECK(coordinator.hasComponent<Position>(current));
+    CHECK(coordinator.getComponent<Position>(current).x == 3.0f);
+    CHECK(coordinator.getEntitySignature(stale).none());
+
+    coordinator.destroyEntity(stale);
+    CHECK(coordinator.entityExists(current));
+    CHECK(coordinator.getLivingEntityCount() == 1);
+}
+
+/** NULL_ENTITY never refers to a living entity */
+void testNullEntity() {
+    EntityManager manager(64);
+    manager.createEntity();
+    CHECK(!manager.entityExists(NULL_ENTITY));
+    manager.destroyEntity(NULL_ENTITY);
+    CHECK(manager.getLivingEntityCount() == 1);
+}
+
+} // namespace
+
+int main() {
+    testSlotReuseBumpsGeneration();
+    testFreeListIsLifo();
+    testStaleHandlesAreIgnored();
+    testNullEntity();
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file GroupTests.cpp
+ * @brief Owning groups: membership and lockstep packed order of the owned storages
+ */
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct Health {
+    int value;
+};
+
+/**
+ * Checks that the group holds exactly the expected members and that every owned
+ * storage keeps them at its front, in the same order
+ */
+void checkGroup(Coordinator &coordinator, const Group<Position, Velocity> &group, const std::vector<Entity> &expected) {
+    CHECK(group.size() == expected.size());
+    for (Entity entity : expected) {
+        CHECK(group.contains(entity));
+    }
+    Span<const Entity> members = group.entities();
+    Position *positions = group.data<Position>();
+    Velocity *velocities = group.data<Velocity>();
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        CHECK(&positions[i] == &coordinator.getComponent<Position>(members[i]));
+        CHECK(&velocities[i] == &coordinator.getComponent<Velocity>(members[i]));
+        CHECK(positions[i].x == static_cast<float>(entityIndex(members[i])));
+        CHECK(velocities[i].y == static_cast<float>(entityIndex(members[i])));
+    }
+    std::size_t visited = 0;
+    group.each([&](Entity entity, Position &position, Velocity &velocity) {
+        CHECK(position.x == static_cast<float>(entityIndex(entity)));
+        CHECK(velocity.y == static_cast<float>(entityIndex(entity)));
+        ++visited;
+    });
+    CHECK(visited == expected.size());
+}
+
+void addPosition(Coordinator &coordinator, Entity entity) {
+    coordinator.addComponent(entity, Position{static_cast<float>(entityIndex(entity)), 0.0f});
+}
+
+void addVelocity(Coordinator &coordinator, Entity entity) {
+    coordinator.addComponent(entity, Velocity{0.0f, static_cast<float>(entityIndex(entity))});
+}
+
+/** A group created over existing entities collects the ones owning every type */
+void testRebuildOverExistingEntities() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    std::vector<Entity> entities = coordinator.createEntities(20);
+    std::vector<Entity> expected;
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        if (i % 2 == 0) {
+            addPosition(coordinator, entities[i]);
+        }
+        if (i % 3 == 0) {
+            addVelocity(coordinator, entities[i]);
+        }
+        if (i % 6 == 0) {
+            expected.push_back(entities[i]);
+        }
+    }
+    auto group = coordinator.group<Position, Velocity>();
+    checkGroup(coordinator, group, expected);
+}
+
+/** Entities join when they get the last owned type and leave when they lose one */
+void testJoinAndLeave() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.registerComponent<Health>();
+    auto group = coordinator.group<Position, Velocity>();
+    std::vector<Entity> entities = coordinator.createEntities(10);
+
+    std::vector<Entity> expected;
+    for (Entity entity : entities) {
+        addPosition(coordinator, entity);
+    }
+    checkGroup(coordinator, group, expected);
+    for (std::size_t i = 0; i < entities.size(); i += 2) {
+        addVelocity(coordinator, entities[i]);
+        expected.push_back(entities[i]);
+        checkGroup(coordinator, group, expected);
+    }
+
+    // A non-owned type does not affect membership
+    coordinator.addComponent(entities[0], Health{5});
+    checkGroup(coordinator, group, expected);
+
+    // Leaving from the middle through either owned type keeps the others in lockstep
+    coordinator.removeComponent<Velocity>(entities[4]);
+    coordinator.removeComponent<Position>(entities[2]);
+    expected = {entities[0], entities[6], entities[8]};
+    checkGroup(coordinator, group, expected);
+    CHECK(coordinator.hasComponent<Position>(entities[4]));
+    CHECK(coordinator.hasComponent<Velocity>(entities[2]));
+
+    // Rejoining appends the member again
+    addVelocity(coordinator, entities[4]);
+    expected.push_back(entities[4]);
+    checkGroup(coordinator, group, expected);
+}
+
+/** Destroying members (or non-members owning one type) keeps the group packed */
+void testDestroy() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    auto group = coordinator.group<Position, Velocity>();
+    std::vector<Entity> entities = coordinator.createEntities(12);
+    std::vector<Entity> expected;
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        addPosition(coordinator, entities[i]);
+        if (i < 8) {
+            addVelocity(coordinator, entities[i]);
+            expected.push_back(entities[i]);
+        }
+    }
+    coordinator.destroyEntity(entities[0]);
+    coordinator.destroyEntity(entities[10]);
+    Entity batch[] = {entities[3], entities[7]};
+    coordinator.destroyEntities(Span<const Entity>(batch, 2));
+    expected = {entities[1], entities[2], entities[4], entities[5], entities[6]};
+    checkGroup(coordinator, group, expected);
+
+    // A recycled slot joins as a new member, the stale handle does not
+    Entity recycled = coordinator.createEntity();
+    addPosition(coordinator, recycled);
+    addVelocity(coordinator, recycled);
+    expected.push_back(recycled);
+    checkGroup(coordinator, group, expected);
+    CHECK(!group.contains(entities[0]));
+}
+
+/** A component type belongs to one group at most */
+void testOwnershipIsExclusive() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.registerComponent<Health>();
+    coordinator.group<Position, Velocity>();
+    bool threw = false;
+    try {
+        coordinator.group<Velocity, Health>();
+    } catch (const std::logic_error &) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+} // namespace
+
+int main() {
+    testRebuildOverExistingEntities();
+    testJoinAndLeave();
+    testDestroy();
+    testOwnershipIsExclusive();
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file ObserverTests.cpp
+ * @brief Lifecycle observers restructuring the world while they are delivered
+ */
+#include <stdexcept>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+/** An onAdd observer growing the same storage does not leave emplaceComponent dangling */
+void testEmplaceAfterStorageGrowth() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    std::vector<Entity> others = coordinator.createEntities(2000);
+    bool spawning = false;
+    coordinator.onAdd<Position>([&](Entity, Position &) {
+        if (spawning) {
+            return;
+        }
+        spawning = true;
+        for (Entity other : others) {
+            coordinator.addComponent(other, Position{0.0f, 0.0f});
+        }
+        spawning = false;
+    });
+
+    Entity entity = coordinator.createEntity();
+    Position &position = coordinator.emplaceComponent<Position>(entity, 3.0f, 4.0f);
+    CHECK(&position == &coordinator.getComponent<Position>(entity));
+    CHECK(position.x == 3.0f && position.y == 4.0f);
+    CHECK(coordinator.getAllEntitiesWith<Position>().size() == others.size() + 1);
+}
+
+/** An onAdd observer removing the component makes emplaceComponent throw instead of dangling */
+void testEmplaceAfterRemoval() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    coordinator.onAdd<Position>([&](Entity entity, Position &) { coordinator.removeComponent<Position>(entity); });
+
+    Entity entity = coordinator.createEntity();
+    bool threw = false;
+    try {
+        coordinator.emplaceComponent<Position>(entity, 1.0f, 2.0f);
+    } catch (const std::out_of_range &) {
+        threw = true;
+    }
+    CHECK(threw);
+    CHECK(!coordinator.hasComponent<Position>(entity));
+}
+
+} // namespace
+
+int main() {
+    testEmplaceAfterStorageGrowth();
+    testEmplaceAfterRemoval();
+    return 0;
+}
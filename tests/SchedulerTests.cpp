@@ -0,0 +1,194 @@
+/**
+ * @file SchedulerTests.cpp
+ * @brief runFrame(): conflict ordering inside a phase, concurrency and phase order
+ */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct Health {
+    int value;
+};
+
+/** Shared by the systems of one test to observe the schedule */
+struct Trace {
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+    std::atomic<bool> writerDone{false};
+    std::atomic<bool> readerSawWriter{true};
+    std::atomic<int> arrived{0};
+    std::atomic<bool> metPartner{true};
+    std::vector<int> phases;
+};
+
+Trace *gTrace = nullptr;
+
+void enter() {
+    int now = gTrace->active.fetch_add(1) + 1;
+    int seen = gTrace->maxActive.load();
+    while (now > seen && !gTrace->maxActive.compare_exchange_weak(seen, now)) {
+    }
+}
+
+void leave() {
+    gTrace->active.fetch_sub(1);
+}
+
+/** Waits (bounded) for the other system of a pair to be running at the same time */
+void meetPartner() {
+    gTrace->arrived.fetch_add(1);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (gTrace->arrived.load() < 2) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            gTrace->metPartner = false;
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+struct PositionWriter : System {
+    void update(float) override {
+        enter();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        gTrace->writerDone = true;
+        leave();
+    }
+};
+
+struct PositionReader : System {
+    void update(float) override {
+        enter();
+        if (!gTrace->writerDone.load()) {
+            gTrace->readerSawWriter = false;
+        }
+        leave();
+    }
+};
+
+struct VelocityWriter : System {
+    void update(float) override { meetPartner(); }
+};
+
+struct HealthWriter : System {
+    void update(float) override { meetPartner(); }
+};
+
+struct Undeclared : System {
+    void update(float) override {
+        enter();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        leave();
+    }
+};
+
+struct OtherUndeclared : Undeclared {};
+
+template <int Phase>
+struct PhaseRecorder : System {
+    void update(float) override { gTrace->phases.push_back(Phase); }
+};
+
+/** Runs one frame long enough for every system at its default rate to be due */
+void runDueFrame(Coordinator &coordinator) {
+    coordinator.runFrame(1.0f / 30.0f);
+}
+
+void makeDefaultWorld(Coordinator &coordinator) {
+    coordinator.init();
+    coordinator.setThreadCount(3);
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.registerComponent<Health>();
+}
+
+/** A reader of a component waits for the earlier-registered writer of the same phase */
+void testConflictingSystemsAreOrdered() {
+    for (int frame = 0; frame < 5; ++frame) {
+        Trace trace;
+        gTrace = &trace;
+        Coordinator coordinator;
+        makeDefaultWorld(coordinator);
+        coordinator.registerSystem<PositionWriter>();
+        coordinator.registerSystem<PositionReader>();
+        coordinator.setSystemAccess<PositionWriter>(Reads<>{}, Writes<Position>{});
+        coordinator.setSystemAccess<PositionReader>(Reads<Position>{}, Writes<>{});
+        runDueFrame(coordinator);
+        CHECK(trace.writerDone);
+        CHECK(trace.readerSawWriter);
+        CHECK(trace.maxActive == 1);
+    }
+}
+
+/** Systems with disjoint writes run concurrently */
+void testIndependentSystemsRunConcurrently() {
+    Trace trace;
+    gTrace = &trace;
+    Coordinator coordinator;
+    makeDefaultWorld(coordinator);
+    coordinator.registerSystem<VelocityWriter>();
+    coordinator.registerSystem<HealthWriter>();
+    coordinator.setSystemAccess<VelocityWriter>(Reads<Position>{}, Writes<Velocity>{});
+    coordinator.setSystemAccess<HealthWriter>(Reads<Position>{}, Writes<Health>{});
+    runDueFrame(coordinator);
+    CHECK(trace.arrived == 2);
+    CHECK(trace.metPartner);
+}
+
+/** A system that declared no access conflicts with every other system */
+void testUndeclaredAccessIsExclusive() {
+    Trace trace;
+    gTrace = &trace;
+    Coordinator coordinator;
+    makeDefaultWorld(coordinator);
+    coordinator.registerSystem<Undeclared>();
+    coordinator.registerSystem<OtherUndeclared>();
+    coordinator.registerSystem<PositionReader>();
+    coordinator.setSystemAccess<PositionReader>(Reads<Position>{}, Writes<>{});
+    trace.writerDone = true;
+    for (int frame = 0; frame < 3; ++frame) {
+        runDueFrame(coordinator);
+    }
+    CHECK(trace.maxActive == 1);
+}
+
+/** Phases run in ascending order, whatever the registration order */
+void testPhasesRunInOrder() {
+    Trace trace;
+    gTrace = &trace;
+    Coordinator coordinator;
+    makeDefaultWorld(coordinator);
+    coordinator.registerSystem<PhaseRecorder<PHASE_RENDER>>();
+    coordinator.registerSystem<PhaseRecorder<PHASE_INPUT>>();
+    coordinator.registerSystem<PhaseRecorder<PHASE_PHYSICS>>();
+    coordinator.setSystemPhase<PhaseRecorder<PHASE_RENDER>>(PHASE_RENDER);
+    coordinator.setSystemPhase<PhaseRecorder<PHASE_INPUT>>(PHASE_INPUT);
+    coordinator.setSystemPhase<PhaseRecorder<PHASE_PHYSICS>>(PHASE_PHYSICS);
+    runDueFrame(coordinator);
+    CHECK(trace.phases == std::vector<int>{PHASE_INPUT, PHASE_PHYSICS, PHASE_RENDER});
+}
+
+} // namespace
+
+int main() {
+    testConflictingSystemsAreOrdered();
+    testIndependentSystemsRunConcurrently();
+    testUndeclaredAccessIsExclusive();
+    testPhasesRunInOrder();
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file SnapshotTests.cpp
+ * @brief Snapshot round trips and rejection of corrupt entity and component state
+ */
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <typeinfo>
+#include <stdexcept>
+#include <string>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+/** Byte offset of the free-list head in an EntityManager snapshot */
+constexpr std::size_t HEAD_OFFSET = sizeof(Entity);
+
+/** Byte offset of the first slot in an EntityManager snapshot */
+constexpr std::size_t SLOTS_OFFSET = 2 * sizeof(Entity);
+
+/** Saves 8 entities, slots 2 and 5 destroyed (free list 5 -> 2 -> end) */
+std::string makeSnapshot() {
+    EntityManager manager(64);
+    Entity entities[8];
+    manager.createEntities(8, entities);
+    manager.destroyEntity(entities[2]);
+    manager.destroyEntity(entities[5]);
+    std::stringstream stream;
+    SnapshotWriter writer(stream);
+    manager.saveSnapshot(writer);
+    return stream.str();
+}
+
+void writeEntity(std::string &bytes, std::size_t offset, Entity value) {
+    std::memcpy(&bytes[offset], &value, sizeof(Entity));
+}
+
+/** Loads bytes into a fresh manager, returning whether it was rejected */
+bool rejects(const std::string &bytes, Entity capacity = 64) {
+    EntityManager manager(capacity);
+    std::stringstream stream(bytes);
+    SnapshotReader reader(stream);
+    try {
+        manager.loadSnapshot(reader);
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+/** A valid snapshot loads and reuses its free slots */
+void testRoundTrip() {
+    std::string bytes = makeSnapshot();
+    EntityManager manager(64);
+    std::stringstream stream(bytes);
+    SnapshotReader reader(stream);
+    manager.loadSnapshot(reader);
+    CHECK(manager.getLivingEntityCount() == 6);
+    CHECK(entityIndex(manager.createEntity()) == 5);
+    CHECK(entityIndex(manager.createEntity()) == 2);
+    CHECK(entityIndex(manager.createEntity()) == 8);
+}
+
+/** Free-list links must stay below the loaded slot count */
+void testRejectsOutOfRangeFreeList() {
+    std::string bytes = makeSnapshot();
+    writeEntity(bytes, HEAD_OFFSET, 40);
+    CHECK(rejects(bytes));
+
+    bytes = makeSnapshot();
+    writeEntity(bytes, SLOTS_OFFSET + 2 * sizeof(Entity), makeEntity(9, 1));
+    CHECK(rejects(bytes));
+}
+
+/** A cyclic free list is rejected instead of looping */
+void testRejectsCyclicFreeList() {
+    std::string bytes = makeSnapshot();
+    writeEntity(bytes, SLOTS_OFFSET + 2 * sizeof(Entity), makeEntity(5, 1));
+    CHECK(rejects(bytes));
+}
+
+/** Alive entities must match their slots, and slots must fit the capacity */
+void testRejectsInconsistentState() {
+    std::string bytes = makeSnapshot();
+    writeEntity(bytes, HEAD_OFFSET, ENTITY_INDEX_MASK);
+    CHECK(rejects(bytes));
+
+    CHECK(rejects(makeSnapshot(), 4));
+    CHECK(rejects(makeSnapshot().substr(0, 20)));
+}
+
+/** Saves a world of 4 entities, the first 3 with a Position */
+std::string makeWorldSnapshot() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    for (int i = 0; i < 4; ++i) {
+        Entity entity = coordinator.createEntity();
+        if (i < 3) {
+            coordinator.addComponent(entity, Position{static_cast<float>(i), 0.0f});
+        }
+    }
+    std::stringstream stream;
+    coordinator.saveSnapshot(stream);
+    return stream.str();
+}
+
+/** Byte offset of the Position type name (preceded by its ID and length) in a world snapshot */
+std::size_t nameOffset(const std::string &bytes) {
+    std::size_t offset = bytes.find(typeid(Position).name());
+    CHECK(offset != std::string::npos);
+    return offset;
+}
+
+/** Byte offset of the first Position owner: after the name, component size, count and tracking flag */
+std::size_t ownersOffset(const std::string &bytes) {
+    return nameOffset(bytes) + std::strlen(typeid(Position).name()) + 2 * sizeof(std::uint32_t) + 1;
+}
+
+/** Loads bytes into a fresh world, returning whether they were rejected */
+bool worldRejects(const std::string &bytes) {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    std::stringstream stream(bytes);
+    try {
+        coordinator.loadSnapshot(stream);
+    } catch (const std::runtime_error &) {
+        return true;
+    }
+    return false;
+}
+
+/** A valid world round-trips, and its component owners are found where expected */
+void testWorldRoundTrip() {
+    std::string bytes = makeWorldSnapshot();
+    Entity first;
+    std::memcpy(&first, &bytes[ownersOffset(bytes)], sizeof(Entity));
+    CHECK(first == makeEntity(0, 0));
+
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Position>();
+    std::stringstream stream(bytes);
+    coordinator.loadSnapshot(stream);
+    CHECK(coordinator.getAllEntitiesWith<Position>().size() == 3);
+    CHECK(coordinator.getComponent<Position>(makeEntity(2, 0)).x == 2.0f);
+}
+
+/** Component owners must be unique living entities whose signature has the type */
+void testRejectsCorruptOwners() {
+    std::string bytes = makeWorldSnapshot();
+    writeEntity(bytes, ownersOffset(bytes) + sizeof(Entity), makeEntity(0, 0));
+    CHECK(worldRejects(bytes));
+
+    bytes = makeWorldSnapshot();
+    writeEntity(bytes, ownersOffset(bytes), makeEntity(30, 0));
+    CHECK(worldRejects(bytes));
+
+    bytes = makeWorldSnapshot();
+    writeEntity(bytes, ownersOffset(bytes), makeEntity(0, 1));
+    CHECK(worldRejects(bytes));
+
+    // Entity 3 is alive but has no Position bit
+    bytes = makeWorldSnapshot();
+    writeEntity(bytes, ownersOffset(bytes), makeEntity(3, 0));
+    CHECK(worldRejects(bytes));
+}
+
+/** Corrupt type IDs and string lengths are rejected without allocating for them */
+void testRejectsCorruptComponentHeaders() {
+    std::string bytes = makeWorldSnapshot();
+    bytes[nameOffset(bytes) - sizeof(std::uint32_t) - 1] = static_cast<char>(MAX_COMPONENTS);
+    CHECK(worldRejects(bytes));
+
+    bytes = makeWorldSnapshot();
+    std::uint32_t length = 0xFFFFFFF0u;
+    std::memcpy(&bytes[nameOffset(bytes) - sizeof(std::uint32_t)], &length, sizeof(length));
+    CHECK(worldRejects(bytes));
+
+    bytes = makeWorldSnapshot();
+    std::uint32_t count = 0xFFFFFFF0u;
+    std::memcpy(&bytes[ownersOffset(bytes) - 1 - sizeof(std::uint32_t)], &count, sizeof(count));
+    CHECK(worldRejects(bytes));
+}
+
+/** Shared<T> components do not prevent saving: they are left out of the snapshot */
+void testSharedComponentsAreSkipped() {
+    Coordinator coordinator;
+    coordinator.init();
+    coordinator.registerComponent<Shared<Position>>();
+    coordinator.registerComponent<Position>();
+    auto origin = Shared<Position>::make(0.0f, 0.0f);
+    Entity entity = coordinator.createEntity();
+    coordinator.addComponent(entity, origin);
+    coordinator.addComponent(entity, Position{1.0f, 2.0f});
+    std::stringstream stream;
+    coordinator.saveSnapshot(stream);
+
+    Coordinator loaded;
+    loaded.init();
+    loaded.registerComponent<Shared<Position>>();
+    loaded.registerComponent<Position>();
+    loaded.loadSnapshot(stream);
+    CHECK(loaded.entityExists(entity));
+    CHECK(loaded.getComponent<Position>(entity).y == 2.0f);
+    CHECK(!loaded.hasComponent<Shared<Position>>(entity));
+    CHECK(loaded.getAllEntitiesWith<Shared<Position>>().empty());
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip();
+    testRejectsOutOfRangeFreeList();
+    testRejectsCyclicFreeList();
+    testRejectsInconsistentState();
+    testWorldRoundTrip();
+    testRejectsCorruptOwners();
+    testRejectsCorruptComponentHeaders();
+    testSharedComponentsAreSkipped();
+    return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file SoATests.cpp
+ * @brief SoA components through every public query API
+ */
+#include <cstddef>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+} // namespace
+
+template <>
+struct SoALayout<Position> : SoAFields<&Position::x, &Position::y> {};
+
+namespace {
+
+constexpr int COUNT = 100;
+
+/** Creates COUNT entities with a Position (x = i), every other one with a Velocity too */
+std::vector<Entity> populate(Coordinator &coordinator) {
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    std::vector<Entity> entities;
+    for (int i = 0; i < COUNT; ++i) {
+        Entity entity = coordinator.createEntity();
+        entities.push_back(entity);
+        coordinator.addComponent(entity, Position{static_cast<float>(i), 0.0f});
+        if (i % 2 == 0) {
+            coordinator.addComponent(entity, Velocity{1.0f, 2.0f});
+        }
+    }
+    return entities;
+}
+
+/** getAllEntitiesWith and view accept SoA components, which yield SoARef proxies */
+void testViews() {
+    Coordinator coordinator;
+    coordinator.init();
+    std::vector<Entity> entities = populate(coordinator);
+    CHECK(isSoA<Position> && !isSoA<Velocity>);
+
+    CHECK(coordinator.getAllEntitiesWith<Position>().size() == COUNT);
+    CHECK(coordinator.getAllEntitiesWith<Position, Velocity>().size() == COUNT / 2);
+
+    std::size_t visited = 0;
+    coordinator.view<Position, Velocity>().each([&](Entity entity, SoARef<Position> position, Velocity &velocity) {
+        position.field<&Position::y>() += velocity.y;
+        CHECK(position.load().x == static_cast<float>(entityIndex(entity)));
+        ++visited;
+    });
+    CHECK(visited == COUNT / 2);
+    for (int i = 0; i < COUNT; ++i) {
+        CHECK(coordinator.getComponent<Position>(entities[i]).load().y == (i % 2 == 0 ? 2.0f : 0.0f));
+    }
+
+    float sum = 0.0f;
+    for (auto [entity, position] : coordinator.view<Position>()) {
+        (void)entity;
+        sum += position.field<&Position::x>();
+    }
+    CHECK(sum == static_cast<float>(COUNT * (COUNT - 1) / 2));
+}
+
+/** Owning groups keep SoA columns in lockstep with the other owned storages */
+void testGroup() {
+    Coordinator coordinator;
+    coordinator.init();
+    std::vector<Entity> entities = populate(coordinator);
+    auto movers = coordinator.group<Position, Velocity>();
+    CHECK(movers.size() == COUNT / 2);
+
+    movers.each([](Entity entity, SoARef<Position> position, Velocity &velocity) {
+        CHECK(position.field<&Position::x>() == static_cast<float>(entityIndex(entity)));
+        position.field<&Position::x>() += velocity.x;
+    });
+    auto columns = movers.columns<Position>();
+    Span<const Entity> members = movers.entities();
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        CHECK(columns.column<&Position::x>()[i] == static_cast<float>(entityIndex(members[i])) + 1.0f);
+    }
+    coordinator.removeComponent<Velocity>(entities[0]);
+    CHECK(movers.size() == COUNT / 2 - 1);
+    CHECK(coordinator.getAllEntitiesWith<Position, Velocity>().size() == COUNT / 2 - 1);
+}
+
+/** In archetype mode SoA components are stored whole in chunks and reached through forEachChunk */
+void testArchetypeChunks() {
+    Coordinator coordinator;
+    coordinator.init({StorageMode::Archetype});
+    populate(coordinator);
+    CHECK(coordinator.getAllEntitiesWith<Position>().size() == COUNT);
+    CHECK(coordinator.getAllEntitiesWith<Position, Velocity>().size() == COUNT / 2);
+
+    std::size_t visited = 0;
+    coordinator.forEachChunk<Position, Velocity>(
+        [&](std::size_t count, const Entity *chunkEntities, Position *positions, Velocity *) {
+            for (std::size_t i = 0; i < count; ++i) {
+                CHECK(positions[i].x == static_cast<float>(entityIndex(chunkEntities[i])));
+            }
+            visited += count;
+        });
+    CHECK(visited == COUNT / 2);
+}
+
+} // namespace
+
+int main() {
+    testViews();
+    testGroup();
+    testArchetypeChunks();
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file SystemManagerTests.cpp
+ * @brief System archetype lists and fixed-rate accumulators kept by the SystemManager
+ */
+#include <cmath>
+#include <cstddef>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct MovementSystem : System {};
+
+struct PositionSystem : System {};
+
+struct FastSystem : System {};
+
+struct SlowSystem : System {};
+
+struct OtherSlowSystem : System {};
+
+/** Counts its update() calls */
+struct CountingSystem : System {
+    int updates = 0;
+
+    void update(float) override { ++updates; }
+};
+
+struct CappedSystem : CountingSystem {};
+
+bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-5f;
+}
+
+/** Number of entities held by the archetypes of a system */
+std::size_t archetypeEntityCount(const System &system) {
+    std::size_t count = 0;
+    for (const Archetype *archetype : system.archetypes) {
+        count += archetype->size();
+    }
+    return count;
+}
+
+/** Archetypes created before a system exists are found when it gets its signature */
+void testSystemRegisteredAfterEntities() {
+    Coordinator coordinator;
+    coordinator.init({StorageMode::Archetype});
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.spawn(100, Position{0.0f, 0.0f}, Velocity{1.0f, 1.0f});
+    coordinator.spawn(50, Position{0.0f, 0.0f});
+
+    Signature movement;
+    movement.set(coordinator.getComponentTypeID<Position>());
+    movement.set(coordinator.getComponentTypeID<Velocity>());
+
+    auto system = coordinator.registerSystem<MovementSystem>();
+    coordinator.setSystemSignature<MovementSystem>(movement);
+    CHECK(system->archetypes.size() == 1);
+    CHECK(archetypeEntityCount(*system) == 100);
+    CHECK(system->entities.size() == 100);
+
+    // Archetypes created later are still appended, once
+    Entity entity = coordinator.createEntity();
+    coordinator.addComponent(entity, Velocity{1.0f, 1.0f});
+    coordinator.addComponent(entity, Position{0.0f, 0.0f});
+    CHECK(archetypeEntityCount(*system) == 101);
+}
+
+/** A signature set before registering the system also matches existing archetypes */
+void testSignatureSetBeforeRegistration() {
+    Coordinator coordinator;
+    coordinator.init({StorageMode::Archetype});
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Velocity>();
+    coordinator.spawn(100, Position{0.0f, 0.0f}, Velocity{1.0f, 1.0f});
+    coordinator.spawn(50, Position{0.0f, 0.0f});
+
+    Signature position;
+    position.set(coordinator.getComponentTypeID<Position>());
+    coordinator.setSystemSignature<PositionSystem>(position);
+
+    auto system = coordinator.registerSystem<PositionSystem>();
+    CHECK(system->archetypes.size() == 2);
+    CHECK(archetypeEntityCount(*system) == 150);
+}
+
+/** Moving one system to another rate re-aligns it only, not the systems that kept theirs */
+void testRateChangeKeepsOtherTimelines() {
+    Coordinator coordinator;
+    coordinator.init();
+    auto fast = coordinator.registerSystem<FastSystem>();
+    auto slow = coordinator.registerSystem<SlowSystem>();
+    auto otherSlow = coordinator.registerSystem<OtherSlowSystem>();
+    fast->setTPS(20.0f);
+    slow->setTPS(10.0f);
+    otherSlow->setTPS(10.0f);
+
+    coordinator.runFrame(0.07f);
+    CHECK(near(fast->getDelta(), 0.02f));
+    CHECK(near(slow->getDelta(), 0.07f));
+    CHECK(near(otherSlow->getDelta(), 0.07f));
+
+    // FastSystem joins the 10 TPS group and adopts its timeline; the others keep theirs
+    fast->setTPS(10.0f);
+    coordinator.runFrame(0.0f);
+    CHECK(near(slow->getDelta(), 0.07f));
+    CHECK(near(otherSlow->getDelta(), 0.07f));
+    CHECK(near(fast->getDelta(), 0.07f));
+
+    // Leaving the group does not touch the remaining members either
+    otherSlow->setTPS(5.0f);
+    coordinator.runFrame(0.01f);
+    CHECK(near(slow->getDelta(), 0.08f));
+    CHECK(near(fast->getDelta(), 0.08f));
+    CHECK(near(otherSlow->getDelta(), 0.08f));
+}
+
+/** A late system catches up with one step per whole threshold, dropping only steps beyond its cap */
+void testCatchUp() {
+    Coordinator coordinator;
+    coordinator.init();
+    auto counting = coordinator.registerSystem<CountingSystem>();
+    auto capped = coordinator.registerSystem<CappedSystem>();
+    counting->setTPS(4.0f);
+    capped->setTPS(4.0f);
+    capped->setMaxCatchUpSteps(2);
+    CHECK(counting->getMaxCatchUpSteps() == System::DEFAULT_MAX_CATCH_UP_STEPS);
+
+    coordinator.runFrame(0.875f);
+    CHECK(counting->updates == 3);
+    CHECK(near(counting->getDelta(), 0.125f));
+    CHECK(capped->updates == 2);
+    CHECK(near(capped->getDelta(), 0.125f));
+
+    coordinator.runFrame(0.125f);
+    CHECK(counting->updates == 4);
+    CHECK(capped->updates == 3);
+}
+
+} // namespace
+
+int main() {
+    testSystemRegisteredAfterEntities();
+    testSignatureSetBeforeRegistration();
+    testRateChangeKeepsOtherTimelines();
+    testCatchUp();
+    return 0;
+}
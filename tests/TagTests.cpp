@@ -0,0 +1,80 @@
+/**
+ * @file TagTests.cpp
+ * @brief Empty marker components in both storage modes
+ */
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+/** Empty marker component */
+struct Frozen {};
+
+static_assert(isTag<Frozen> && !isTag<Position>);
+
+/** Tags are stored without data: every accessor yields the single tag instance */
+void testTags(StorageMode mode) {
+    Coordinator coordinator;
+    coordinator.init({mode});
+    coordinator.registerComponent<Position>();
+    coordinator.registerComponent<Frozen>();
+
+    std::vector<Entity> entities;
+    for (int i = 0; i < 1000; ++i) {
+        Entity entity = coordinator.createEntity();
+        entities.push_back(entity);
+        coordinator.addComponent(entity, Position{static_cast<float>(i), 0.0f});
+        if (i % 2) {
+            coordinator.addComponent(entity, Frozen{});
+        }
+    }
+    for (int i = 0; i < 1000; i += 4) {
+        coordinator.removeComponent<Frozen>(entities[i + 1]);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        bool frozen = i % 4 == 3;
+        CHECK(coordinator.hasComponent<Frozen>(entities[i]) == frozen);
+        CHECK(coordinator.getComponent<Position>(entities[i]).x == static_cast<float>(i));
+        if (frozen) {
+            CHECK(&coordinator.getComponent<Frozen>(entities[i]) == &tagInstance<Frozen>());
+        }
+    }
+    CHECK(coordinator.getAllEntitiesWith<Position, Frozen>().size() == 250);
+}
+
+/** In archetype mode a tag adds no column, so rows per chunk are unchanged */
+void testArchetypeTagsTakeNoChunkSpace() {
+    constexpr ComponentTypeID POSITION = 0;
+    constexpr ComponentTypeID FROZEN = 1;
+    ArchetypeStorage storage;
+    storage.registerComponent<Position>(POSITION);
+    storage.registerComponent<Frozen>(FROZEN);
+
+    storage.insertData(0, POSITION, Position{1.0f, 2.0f});
+    storage.insertData(1, POSITION, Position{3.0f, 4.0f});
+    storage.insertData(1, FROZEN, Frozen{});
+
+    const std::vector<Archetype *> &archetypes = storage.getArchetypes();
+    CHECK(archetypes.size() == 2);
+    CHECK(archetypes[0]->chunkCapacity() == archetypes[1]->chunkCapacity());
+    CHECK(archetypes[1]->hasColumn(FROZEN));
+    CHECK(&storage.getData<Frozen>(1, FROZEN) == &tagInstance<Frozen>());
+    CHECK(storage.getData<Position>(1, POSITION).y == 4.0f);
+    CHECK(archetypes[1]->getChunk(0).entities()[0] == 1);
+}
+
+} // namespace
+
+int main() {
+    testTags(StorageMode::SparseSet);
+    testTags(StorageMode::Archetype);
+    testArchetypeTagsTakeNoChunkSpace();
+    return 0;
+}
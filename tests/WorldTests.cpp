@@ -0,0 +1,160 @@
+/**
+ * @file WorldTests.cpp
+ * @brief Multiple worlds: shared registrations, cloneWorld and moveEntities
+ */
+#include <cstddef>
+#include <vector>
+#include "Check.hpp"
+#include "ECS.hpp"
+
+Coordinator gCoordinator;
+
+namespace {
+
+struct Position {
+    float x, y;
+};
+
+struct Velocity {
+    float x, y;
+};
+
+struct MovementSystem : System {};
+
+Signature movementSignature(Coordinator &coordinator) {
+    Signature signature;
+    signature.set(coordinator.getComponentTypeID<Position>());
+    signature.set(coordinator.getComponentTypeID<Velocity>());
+    return signature;
+}
+
+/** Builds a world of 30 entities (a third of them destroyed), with a movement system */
+std::vector<Entity> populate(Coordinator &world) {
+    world.init();
+    world.registerComponent<Position>();
+    world.registerComponent<Velocity>();
+    world.registerSystem<MovementSystem>();
+    world.setSystemSignature<MovementSystem>(movementSignature(world));
+    std::vector<Entity> alive;
+    std::vector<Entity> entities = world.createEntities(30);
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        if (i % 3 == 2) {
+            world.destroyEntity(entities[i]);
+            continue;
+        }
+        world.addComponent(entities[i], Position{static_cast<float>(i), 1.0f});
+        if (i % 2 == 0) {
+            world.addComponent(entities[i], Velocity{2.0f, static_cast<float>(i)});
+        }
+        alive.push_back(entities[i]);
+    }
+    return alive;
+}
+
+/** initFrom shares the component types, in the same IDs, without any entity */
+void testInitFrom() {
+    Coordinator prototype;
+    populate(prototype);
+    Coordinator world;
+    world.initFrom(prototype);
+    CHECK(world.getComponentTypeID<Position>() == prototype.getComponentTypeID<Position>());
+    CHECK(world.getComponentTypeID<Velocity>() == prototype.getComponentTypeID<Velocity>());
+    CHECK(world.getLivingEntityCount() == 0);
+    Entity entity = world.createEntity();
+    world.addComponent(entity, Velocity{1.0f, 2.0f});
+    CHECK(world.getComponent<Velocity>(entity).y == 2.0f);
+}
+
+/** A clone has the same handles, components, signatures and system members */
+void testCloneWorld() {
+    Coordinator source;
+    std::vector<Entity> alive = populate(source);
+    Coordinator target;
+    target.init();
+    target.registerSystem<MovementSystem>();
+    target.registerComponent<Velocity>();
+    target.registerComponent<Position>();
+    target.setSystemSignature<MovementSystem>(movementSignature(target));
+    Entity extra[40];
+    target.createEntities(40, extra);
+
+    // Cloning twice into the same target overwrites the first copy
+    source.cloneWorld(target);
+    source.cloneWorld(target);
+    CHECK(target.getLivingEntityCount() == source.getLivingEntityCount());
+    for (Entity entity : alive) {
+        CHECK(target.entityExists(entity));
+        CHECK(target.getEntitySignature(entity) == source.getEntitySignature(entity));
+        CHECK(target.getComponent<Position>(entity).x == source.getComponent<Position>(entity).x);
+        CHECK(target.hasComponent<Velocity>(entity) == source.hasComponent<Velocity>(entity));
+        if (source.hasComponent<Velocity>(entity)) {
+            CHECK(target.getComponent<Velocity>(entity).y == source.getComponent<Velocity>(entity).y);
+        }
+    }
+    auto sourceSystem = source.getSystem<MovementSystem>();
+    auto targetSystem = target.getSystem<MovementSystem>();
+    CHECK(targetSystem->entities.size() == sourceSystem->entities.size());
+    for (Entity entity : sourceSystem->entities) {
+        CHECK(targetSystem->entities.contains(entity));
+    }
+
+    // The worlds are independent afterwards, and free slots are reused identically
+    source.getComponent<Position>(alive[0]).x = 100.0f;
+    CHECK(target.getComponent<Position>(alive[0]).x == 0.0f);
+    CHECK(source.createEntity() == target.createEntity());
+}
+
+/** Moved entities leave the source and arrive with new handles and all their components */
+void testMoveEntities() {
+    Coordinator source;
+    std::vector<Entity> alive = populate(source);
+    Coordinator target;
+    target.initFrom(source);
+    target.registerSystem<MovementSystem>();
+    target.setSystemSignature<MovementSystem>(movementSignature(target));
+    Entity resident = target.createEntity();
+
+    std::vector<Entity> moving(alive.begin(), alive.begin() + 6);
+    Entity stale = alive[6];
+    source.destroyEntity(stale);
+    moving.push_back(stale);
+
+    int sourceRemovals = 0;
+    int targetAdds = 0;
+    source.onRemove<Position>([&sourceRemovals](Entity) { ++sourceRemovals; });
+    target.onAdd<Position>([&targetAdds](Entity, Position &) { ++targetAdds; });
+    std::size_t sourceMovers = source.getSystem<MovementSystem>()->entities.size();
+    std::vector<Entity> moved = source.moveEntities(Span<const Entity>(moving.data(), moving.size()), target);
+
+    CHECK(moved.size() == moving.size());
+    CHECK(moved.back() == NULL_ENTITY);
+    std::size_t movedMovers = 0;
+    for (std::size_t i = 0; i + 1 < moving.size(); ++i) {
+        Entity from = moving[i];
+        Entity to = moved[i];
+        CHECK(!source.entityExists(from));
+        CHECK(target.entityExists(to));
+        CHECK(to != resident);
+        CHECK(target.getComponent<Position>(to).x == static_cast<float>(entityIndex(from)));
+        bool mover = target.hasComponent<Velocity>(to);
+        CHECK(mover == (entityIndex(from) % 2 == 0));
+        CHECK(target.getSystem<MovementSystem>()->entities.contains(to) == mover);
+        movedMovers += mover;
+    }
+    CHECK(source.getLivingEntityCount() == alive.size() - moving.size());
+    CHECK(source.getAllEntitiesWith<Position>().size() == alive.size() - moving.size());
+    CHECK(target.getLivingEntityCount() == 7);  // the resident and the six moved entities
+    CHECK(source.getSystem<MovementSystem>()->entities.size() == sourceMovers - movedMovers);
+    // The components change worlds: no event in either of them
+    CHECK(sourceRemovals == 0);
+    CHECK(targetAdds == 0);
+}
+
+} // namespace
+
+int main() {
+    testInitFrom();
+    testCloneWorld();
+    testMoveEntities();
+    return 0;
+}